@@ -2,17 +2,37 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
-#define MAX_COLIS 100
-#define MAX_VEHICULES 10
-#define MAX_TOURNEE 50
 #define MAX_VILLES 14
 #define FLT_MAX 3.40282347E+38F // Valeur maximale pour un float
 #define INF 1e9                 // Représente l'infini
 
 #include "cJSON/cJSON.h" // Inclure la bibliothèque cJSON
 
+// Parallélisme OpenMP (compiler avec -fopenmp ; sinon tout s'exécute sur un seul thread)
+#ifdef _OPENMP
+#include <omp.h>
+#define OMP_PRAGMA(...) _Pragma(#__VA_ARGS__) // directive OpenMP, ignorée sans -fopenmp
+#else
+#define OMP_PRAGMA(...)
+#endif
+
+// Noyaux SIMD x86 sélectionnés à l'exécution (GCC/Clang)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FW_SIMD_X86 1
+#endif
+
 // Définition des structures
 // Structure pour les attributs d’une arete
 typedef struct EdgeAttr
@@ -47,37 +67,557 @@ typedef struct Graph
     char **cityNames; // Tableau des noms des villes
 } Graph;
 
+// Structure pour le graphe compact (CSR : Compressed Sparse Row)
+// Les aretes sortantes de u occupent les indices offsets[u] .. offsets[u + 1] - 1
+// des tableaux contigus ci-dessous (un tableau par attribut).
+typedef struct CSRGraph
+{
+    int V;              // nombre de sommets
+    int E;              // nombre d'aretes
+    int *offsets;       // debut des aretes de chaque sommet (taille V + 1)
+    int *dest;          // destination de chaque arete (taille E)
+    float *distance;    // colonnes des attributs d'arete (taille E)
+    float *baseTime;
+    float *cost;
+    int *roadType;
+    float *reliability;
+    int *restrictions;
+    int *toll;
+    int *nameOffsets;   // debut du nom de chaque ville dans names (taille V + 1)
+    char *names;        // noms des villes concatenes, termines par '\0'
+    void *mapping;      // fichier instantané projeté en mémoire (NULL si tableaux alloués)
+    size_t mappingSize;
+} CSRGraph;
+
+// Index inverse du CSR : arcs entrants de chaque sommet. Les attributs ne sont pas recopiés,
+// edge[i] renvoie à l'arc correspondant du CSR direct.
+typedef struct ReverseCSR
+{
+    int V;
+    int E;
+    int *offsets; // arcs entrants de v : indices offsets[v] .. offsets[v + 1] - 1
+    int *source;  // origine de chaque arc entrant
+    int *edge;    // indice de l'arc dans le CSR direct
+} ReverseCSR;
+
+// Nature d'un arc dont la cible est déjà découverte lors d'un parcours en profondeur
+typedef enum
+{
+    DFS_BACK_EDGE,         // cible sur le chemin courant (grise) : l'arc ferme un circuit
+    DFS_FORWARD_CROSS_EDGE // cible déjà terminée (noire) : arc avant ou transverse
+} DFSEdgeKind;
+
+// Rappels d'un parcours en profondeur. Chaque rappel est facultatif (NULL) ; parent vaut -1
+// pour une racine. Retourner false interrompt le parcours.
+typedef struct DFSVisitor
+{
+    bool (*preVisit)(void *context, int v, int parent);  // découverte de v
+    bool (*postVisit)(void *context, int v, int parent); // tous les arcs de v examinés
+    bool (*nonTreeEdge)(void *context, int u, int v, int parent, DFSEdgeKind kind); // arc u -> v hors arbre
+    void *context;
+} DFSVisitor;
+
+// Moteur de parcours en profondeur à pile explicite : la profondeur n'est limitée que par
+// la mémoire, pas par la pile d'appels. Les sommets découverts et ceux du chemin courant
+// sont des ensembles de bits ; la pile garde, pour chaque niveau, le sommet et le prochain
+// arc à examiner. Le moteur se réutilise d'une racine à l'autre sans être remis à zéro.
+typedef struct DFSEngine
+{
+    int V;
+    uint64_t *visited; // sommets découverts
+    uint64_t *onPath;  // sommets du chemin courant
+    int *stack;        // chemin courant
+    int *edgeIter;     // prochain arc à examiner à chaque niveau
+    int maxDepth;      // profondeur maximale atteinte depuis la dernière remise à zéro
+} DFSEngine;
+
+// Parcours en largeur à direction optimisée : une étape descendante part de la file des
+// sommets de la frontière et examine leurs arcs sortants ; une étape montante parcourt les
+// sommets non visités (ensemble de bits, 64 par mot) et cherche parmi leurs arcs entrants
+// un parent dans la frontière. La seconde gagne quand la frontière couvre une grande part
+// du graphe. Niveaux et parents restent disponibles après le parcours.
+typedef struct BFSTree
+{
+    int V;
+    int *level;         // distance en arcs depuis la source (-1 : non atteint)
+    int *parent;        // parent dans l'arbre du parcours (-1 : source ou non atteint)
+    uint64_t *visited;  // sommets atteints
+    uint64_t *frontier; // frontière courante (étapes montantes)
+    uint64_t *next;     // frontière suivante (étapes montantes)
+    int *queue;         // frontière sous forme de liste (étapes descendantes)
+    int reached;        // sommets atteints par le dernier parcours
+    int depth;          // plus grand niveau atteint
+    int topDownSteps;
+    int bottomUpSteps;
+} BFSTree;
+
+#define BFS_ALPHA 14 // montant dès que les arcs de la frontière dépassent 1/ALPHA des arcs restants
+#define BFS_BETA 24  // retour au descendant quand la frontière passe sous V/BETA sommets
+
+// Composantes faiblement connexes (arcs pris sans leur sens) étiquetées par union-find
+// parallèle : label[v] numérote les composantes dans l'ordre de leur plus petit sommet.
+// findConnectedComponentsCSR ne suit que les arcs sortants : les deux coïncident sur un
+// réseau à double sens, et sur le réseau symétrisé dans tous les cas.
+typedef struct ComponentLabels
+{
+    int V;
+    int count;  // nombre de composantes
+    int *label; // composante de chaque sommet (0 .. count - 1)
+    int *size;  // nombre de sommets de chaque composante
+} ComponentLabels;
+
+#define UF_NEIGHBOR_ROUNDS 2 // arcs par sommet liés avant l'échantillonnage (Afforest)
+#define UF_SAMPLES 1024      // sommets tirés pour repérer la composante géante
+
+// Minimum, maximum et somme d'un attribut d'arête
+typedef struct AttrStats
+{
+    float min;
+    float max;
+    double sum;
+} AttrStats;
+
+#define STATS_DEGREE_BUCKETS 16 // histogramme des degrés : 0 .. 14, puis 15 et plus
+#define STATS_ROAD_TYPES 8      // types de route 0 .. 6, puis « autres »
+#define STATS_BFS_SAMPLES 4     // parcours en largeur de l'estimation du diamètre
+
+// Statistiques du réseau calculées en une passe sur le CSR (répartie entre les threads),
+// plus quelques parcours en largeur pour estimer le diamètre. Exportables en JSON.
+typedef struct GraphStats
+{
+    int V;
+    int E;
+    double density; // en % des V (V - 1) arcs possibles (0 si V < 2)
+    int minOutDegree, maxOutDegree;
+    int minInDegree, maxInDegree;
+    int outDegreeHistogram[STATS_DEGREE_BUCKETS];
+    int inDegreeHistogram[STATS_DEGREE_BUCKETS];
+    AttrStats distance, baseTime, cost, reliability, toll;
+    int roadTypes[STATS_ROAD_TYPES];
+    int tollEdges;       // arcs avec au moins un péage
+    int restrictedEdges; // arcs portant au moins une restriction
+    int diameter;        // borne inférieure du diamètre (en arcs), par BFS échantillonnés
+    int diameterSamples;
+    double seconds; // durée du calcul
+} GraphStats;
+
+// Mémoire de travail des tests d'accessibilité bidirectionnels, réutilisable d'un appel à
+// l'autre : un sommet est marqué s'il porte le numéro de génération de l'appel en cours,
+// si bien que rien n'est remis à zéro entre deux appels.
+typedef struct ReachQuery
+{
+    int V;
+    unsigned int generation;
+    unsigned int *stamp[2]; // [0] atteint depuis src, [1] mène à dest
+    int *queue[2];
+    int visited; // sommets marqués par le dernier appel
+} ReachQuery;
+
+// Liste triée d'intervalles disjoints [bounds[2i], bounds[2i+1]] de numéros postfixes
+typedef struct IntervalList
+{
+    int count;
+    int *bounds;
+} IntervalList;
+
+// Index d'accessibilité : composantes fortement connexes (CFC), DAG de condensation et
+// fermeture transitive compressée en intervalles. Une forêt couvrante du DAG numérote les
+// composantes en ordre postfixe ; chaque composante garde la liste des intervalles de
+// numéros qu'elle atteint, si bien que « src atteint dest » se lit par recherche dichotomique.
+typedef struct ReachabilityIndex
+{
+    int V;
+    int C;                // nombre de composantes fortement connexes
+    int *component;       // CFC de chaque sommet (en ordre topologique inverse à la construction)
+    int *dagOffsets;      // DAG de condensation (CSR sur les composantes, taille C + 1)
+    int *dagDest;
+    int *post;            // numéro postfixe de chaque composante
+    IntervalList *labels; // numéros postfixes atteignables depuis chaque composante
+    int intervals;        // nombre total d'intervalles (taille de l'index)
+} ReachabilityIndex;
+
+// État de l'algorithme de Tarjan, porté par les rappels du moteur de parcours
+typedef struct TarjanState
+{
+    int *component;
+    int *order;    // ordre de découverte
+    int *low;
+    int *stack;    // sommets des composantes ouvertes
+    bool *onStack;
+    int top;
+    int counter;
+    int C;
+} TarjanState;
+
+// Tri topologique par le moteur de parcours : ordre postfixe inverse, rempli de la fin vers le début
+typedef struct TopologicalState
+{
+    int *order;
+    int next; // prochaine case libre (en partant de la fin)
+} TopologicalState;
+
+// Règle de détection de cycles. Les routes de graph.json sont des arcs orientés (addEdge
+// n'insère que src -> dest) : seule la règle orientée (arc arrière vers un sommet gris du
+// parcours en trois couleurs) est juste. La règle non orientée, « voisin déjà visité autre
+// que le parent », est conservée pour comparaison.
+typedef enum
+{
+    CYCLE_DIRECTED,
+    CYCLE_UNDIRECTED
+} CycleMode;
+
+// Bilan des circuits d'un graphe orienté, obtenu en un seul parcours (Tarjan) : un sommet
+// est sur un circuit si et seulement si sa CFC compte plusieurs sommets ou s'il porte une
+// boucle. Les sommets concernés sont regroupés par CFC cyclique.
+typedef struct CycleReport
+{
+    int V;
+    int components;     // CFC contenant au moins un circuit
+    int members;        // sommets appartenant à un circuit
+    int *memberOffsets; // sommets de la k-ième CFC cyclique : memberOffsets[k] .. memberOffsets[k + 1] - 1
+    int *memberList;
+    int *cycle;         // un circuit exemple (premier arc arrière rencontré), sans répéter le départ
+    int cycleLength;    // 0 si le graphe est acyclique
+} CycleReport;
+
+// État du parcours de CycleReport : Tarjan, parent dans l'arbre DFS et premier arc arrière
+typedef struct CycleState
+{
+    TarjanState tarjan;
+    int *parent;
+    bool *selfLoop;
+    int backSource; // -1 tant qu'aucun arc arrière n'a été vu
+    int backTarget;
+} CycleState;
+
+// En-tête de l'instantané binaire (graph.bin) : les sections qui suivent sont les
+// tableaux du CSR tels quels, alignés sur SNAPSHOT_ALIGN octets, dans l'ordre
+// offsets, nameOffsets, dest, distance, baseTime, cost, roadType, reliability,
+// restrictions, toll, names.
+#define SNAPSHOT_MAGIC "GRAPHCSR"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_ENDIAN_TAG 0x01020304u
+#define SNAPSHOT_ALIGN 64
+#define SNAPSHOT_SECTIONS 11
+
+typedef struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t endianTag; // détecte un fichier produit sur une machine d'autre boutisme
+    uint32_t V;
+    uint32_t E;
+    uint64_t namesSize;
+    uint64_t sourceSize;  // taille et date du graph.json d'origine (0 si inconnues)
+    int64_t sourceMtime;
+    uint64_t checksum;    // somme de contrôle des sections
+    uint64_t fileSize;
+    uint64_t sectionOffset[SNAPSHOT_SECTIONS];
+} SnapshotHeader;
+
+// Noyau de calcul de Floyd-Warshall par blocs
+typedef enum FWKernel
+{
+    FW_KERNEL_AUTO,      // meilleur noyau disponible sur le processeur
+    FW_KERNEL_SCALAIRE,  // C portable
+    FW_KERNEL_SSE,       // 4 flottants par instruction
+    FW_KERNEL_AVX2       // 8 flottants par instruction
+} FWKernel;
+
+#define FW_BLOCK 64 // côté d'une tuile (64 x 64 flottants = 16 Ko)
+
+// Matrice de distances V x V allouée sur le tas (et non sur la pile) : chaque ligne
+// commence sur une frontière de DIST_MATRIX_ALIGN octets et est complétée jusqu'à un
+// multiple de cette taille, pour des accès vectoriels alignés d'une ligne à l'autre.
+#define DIST_MATRIX_ALIGN 64
+#define DIST_MATRIX_HUGE (4u << 20) // au-delà (Linux), pages de 2 Mo transparentes
+
+typedef struct DistMatrix
+{
+    int n;        // nombre de lignes et de colonnes
+    int stride;   // nombre de flottants par ligne (n arrondi au multiple supérieur)
+    float *data;  // ligne i : data + i * stride
+    size_t bytes; // taille de l'allocation
+    bool mapped;  // allouée par mmap (pages énormes) plutôt que par le tas
+} DistMatrix;
+
+// Tas d-aire indexé : file de priorité de sommets avec diminution de clé en O(log V)
+#define HEAP_ARITY 4 // 4 fils par nœud : arbre moins profond, fils contigus en mémoire
+
+typedef struct IndexedHeap
+{
+    int size;
+    int capacity;
+    int *items;  // sommets rangés en tas
+    float *keys; // clé de chaque case du tas
+    int *pos;    // position de chaque sommet dans le tas (-1 si absent)
+} IndexedHeap;
+
+// Algorithme de plus courts chemins à source unique
+typedef enum ShortestPathMode
+{
+    SP_AUTO,        // Dijkstra, ou SPFA si un poids négatif est détecté
+    SP_DIJKSTRA,
+    SP_BELLMAN_FORD,
+    SP_SPFA         // Bellman-Ford à file (SPFA + SLF)
+} ShortestPathMode;
+
+// Plus courts chemins groupés : un lot de K sources relâchées au cours des mêmes passes.
+// Les étiquettes sont rangées sommet par sommet (dist[v * stride + s]) : les K sources
+// d'un même sommet sont contiguës et un seul parcours d'une arête les met toutes à jour.
+#define BATCH_LANES 8 // largeur AVX2 (8 flottants) ; stride est un multiple de BATCH_LANES
+
+typedef struct MultiSourcePaths
+{
+    int V;
+    int K;       // nombre de sources du lot
+    int stride;  // K arrondi au multiple de BATCH_LANES supérieur
+    float *dist; // dist[v * stride + s] : coût depuis la source s
+    float *time; // temps cumulé correspondant
+    int *pred;   // prédécesseur de v sur le chemin depuis la source s
+} MultiSourcePaths;
+
+// Plus court chemin sous contrainte de ressource : étiquettes (coût, temps) Pareto-optimales.
+// Les étiquettes sont rangées en colonnes dans un réservoir commun qui grandit à la demande.
+#define RCSP_BUCKETS 1024 // seaux de la file circulaire (largeur = coût d'arête max / (RCSP_BUCKETS - 2))
+
+typedef struct RCSPLabels
+{
+    int V;
+    int count;                // étiquettes créées
+    int capacity;             // taille du réservoir
+    int *node;                // sommet atteint
+    int *parent;              // étiquette précédente sur le chemin (-1 pour la source)
+    float *cost;
+    float *time;
+    int *next;                // suivante dans le même seau de la file
+    int *nextAtNode;          // suivante dans l'ensemble de Pareto du sommet (coûts croissants)
+    unsigned char *dominated; // écartée par une étiquette meilleure sur les deux critères
+    int *head;                // par sommet : étiquette de coût minimal (-1 si inaccessible)
+    int settled;              // étiquettes étendues
+} RCSPLabels;
+
+// Critère minimisé par les requêtes point à point
+typedef enum RouteMetric
+{
+    METRIC_DISTANCE,
+    METRIC_TIME, // baseTime
+    METRIC_COST
+} RouteMetric;
+
+// Hiérarchie de contraction : les sommets sont numérotés par rang de contraction et chaque
+// arc (original ou raccourci) est rangé du côté de son extrémité de plus petit rang.
+// Une requête ne remonte que vers des sommets de rang supérieur, depuis les deux bouts.
+#define CH_MAGIC "GRAPHCH"
+#define CH_VERSION 1
+#define CH_WITNESS_LIMIT 500 // sommets fixés au plus par recherche de témoin
+
+typedef struct CHGraph
+{
+    int V;
+    RouteMetric metric;
+    uint64_t graphHash; // empreinte du graphe d'origine (structure + poids du critère)
+    int shortcuts;      // nombre de raccourcis ajoutés
+    int *rank;          // rang de contraction de chaque sommet
+    int *upOffsets;     // arcs u -> w avec rank[w] > rank[u], rangés en u
+    int *upTarget;
+    float *upWeight;
+    int *upMiddle;      // sommet contourné par un raccourci (-1 pour une route réelle)
+    int *downOffsets;   // arcs u -> w avec rank[u] > rank[w], rangés en w
+    int *downSource;
+    float *downWeight;
+    int *downMiddle;
+} CHGraph;
+
+// Mémoire de travail d'une requête, réutilisable : les distances sont marquées d'un numéro
+// de génération, si bien qu'aucune remise à zéro en O(V) n'est nécessaire entre requêtes.
+typedef struct CHQuery
+{
+    unsigned int generation;
+    unsigned int *stamp[2]; // [0] recherche avant depuis s, [1] recherche arrière depuis t
+    float *dist[2];
+    int *pred[2];
+    IndexedHeap *heap[2];
+    int settled; // sommets fixés par la dernière requête
+} CHQuery;
+
+// A* avec bornes inférieures par points de repère (ALT) : distances de et vers K repères,
+// rangées sommet par sommet (from[v * K + i]) pour qu'une évaluation lise une seule zone.
+#define ALT_LANDMARKS 8 // nombre de repères par défaut
+
+typedef struct LandmarkIndex
+{
+    int V;
+    int K;
+    RouteMetric metric;
+    int *landmarks; // sommets choisis comme repères
+    float *from;    // from[v * K + i] : distance du repère i à v (INF si inaccessible)
+    float *to;      // to[v * K + i] : distance de v au repère i
+} LandmarkIndex;
+
+// Mémoire de travail d'A*, réutilisable d'une requête à l'autre (marquage par génération)
+typedef struct AStarQuery
+{
+    unsigned int generation;
+    unsigned int *stamp;
+    float *g; // distance depuis la source
+    int *pred;
+    IndexedHeap *heap; // clé : g + borne inférieure vers la cible
+    int settled;       // sommets fixés par la dernière requête
+} AStarQuery;
+
 // ---------- STRUCTURES DE DONNEES GLOUTONNE  ----------
-typedef struct Colis
+#define ARENA_BLOCK_SIZE (1 << 16) // taille minimale d'un bloc d'arène (octets)
+#define ARENA_ALIGN 64             // alignement des zones (une ligne de cache)
+
+typedef struct ArenaBlock
+{
+    struct ArenaBlock *next;
+    size_t size; // octets utilisables après l'en-tête
+    size_t used;
+} ArenaBlock;
+
+// Arène : zones découpées à la suite dans de grands blocs, libérées toutes ensemble
+typedef struct Arena
+{
+    ArenaBlock *head;
+    size_t bytes; // total réservé auprès de malloc
+} Arena;
+
+// Dimensions de capacité : chaque colis a une charge et chaque véhicule une capacité par
+// dimension ; un colis n'entre dans un véhicule que s'il tient dans toutes les dimensions
+#define CAPACITE_DIMENSIONS 2
+#define DIM_POIDS 0  // kg
+#define DIM_VOLUME 1
+
+// Lot de colis en colonnes (un tableau par champ), agrandi à la demande dans son arène ;
+// le numéro d'un colis est son indice
+typedef struct LotColis
+{
+    Arena arena;
+    int count;
+    int capacity;
+    int *villeDest;
+    float *charge[CAPACITE_DIMENSIONS]; // poids, volume
+    int *urgent;                        // 1 si urgent, 0 sinon
+} LotColis;
+
+// Flotte en colonnes, le numéro d'un véhicule est son indice. Les livraisons de toutes les
+// tournées sont rangées dans une même paire de colonnes et chaînées véhicule par véhicule :
+// une tournée n'a pas de longueur maximale.
+typedef struct Flotte
 {
-    int id;
-    int villeDest;
-    float poids;
-    float volume;
-    int urgent; // 1 si urgent, 0 sinon
-} Colis;
+    Arena arena;
+    int count;
+    int capacity;
+    float *capaciteMax[CAPACITE_DIMENSIONS];
+    float *capaciteRestante[CAPACITE_DIMENSIONS];
+    int *villeActuelle;
+    int *nbLivraisons;
+    int *premiereLivraison; // -1 : tournée vide
+    int *derniereLivraison;
+    int nbLivraisonsTotal;
+    int capaciteLivraisons;
+    int *livraisonVille;
+    int *livraisonSuivante; // livraison suivante du même véhicule (-1 : fin de tournée)
+} Flotte;
 
-typedef struct Vehicule
+// File de priorité des colis à affecter : tas 4-aire (HEAP_ARITY) de clés de 64 bits qui
+// rangent les colis par classe de priorité (voir classeColis), puis par numéro. La clé
+// contient le numéro du colis : le tas ne range que des clés. Un colis arrivé après coup
+// s'insère en O(log n), sans retrier la file.
+typedef struct FileColis
 {
-    int id;
-    float capaciteMax;
-    float capaciteRestante;
-    int villeActuelle;
-    int tournee[MAX_TOURNEE];
-    int nbLivraisons;
-} Vehicule;
+    int size;
+    int capacity;
+    uint64_t *keys;
+} FileColis;
 
+// Oracle des distances routières de l'affectation gloutonne : la ligne des plus courtes
+// distances depuis une ville n'est calculée (Dijkstra sur le réseau chargé) que la
+// première fois qu'un véhicule y est demandé, puis conservée d'un colis à l'autre. Le coût
+// suit le nombre de villes de départ distinctes, et non V².
 typedef struct Carte
 {
-    float distances[MAX_VILLES][MAX_VILLES]; // Matrice de distances entre villes
+    const CSRGraph *csr;
+    const float *weight; // critère des distances (colonne du CSR)
+    int V;
+    int *rowOf;          // ligne de chaque ville de départ (-1 : pas encore calculée)
+    float *rows;         // lignes calculées, V distances chacune (INF : ville inaccessible)
+    int nbRows;
+    int capacity;        // lignes allouées
+    IndexedHeap *heap;
 } Carte;
 
+#define VEHICLE_INDEX_CANDIDATES 32 // villes les plus proches retenues par destination
+#define VEHICLE_INDEX_ECHECS 64      // charges refusées faute de capacité gardées en mémoire
+#define AFFECTATION_CAPACITE -1     // colis non affecté : aucun véhicule assez grand
+#define AFFECTATION_INACCESSIBLE -2 // colis non affecté : véhicules assez grands, mais aucun ne rejoint la destination
+
+// Choix du véhicule d'un colis parmi ceux où il tient dans toutes les dimensions : toujours
+// dans la ville la plus proche de la destination, puis selon le mode
+typedef enum ModeAffectation
+{
+    AFFECTATION_PROCHE,     // le plus juste en poids
+    AFFECTATION_REMPLISSAGE // véhicules entamés d'abord, le mieux rempli toutes dimensions (voir resteApresCharge)
+} ModeAffectation;
+
+// Villes de départ les plus proches d'une destination (par distance croissante), parmi
+// celles qui ont encore un véhicule utile ; complete : aucune autre ville n'est utile
+typedef struct CityCandidates
+{
+    int count;
+    bool complete;
+    int city[VEHICLE_INDEX_CANDIDATES];
+    float distance[VEHICLE_INDEX_CANDIDATES];
+} CityCandidates;
+
+// Index des véhicules pour l'affectation gloutonne : dans chaque ville, un arbre binaire
+// de recherche équilibré (treap) range les véhicules par poids restant, et chaque nœud
+// garde le maximum de chaque dimension dans son sous-arbre ; la recherche du véhicule le
+// plus juste en poids qui accepte aussi le volume écarte ainsi les sous-arbres trop
+// petits. Pour chaque destination, les villes occupées les plus proches sont gardées en
+// mémoire.
+typedef struct VehicleIndex
+{
+    const Flotte *flotte;
+    ModeAffectation mode;
+    int nbVehicules;
+    int V;
+    float chargeMin[CAPACITE_DIMENSIONS]; // plus petit colis dans chaque dimension
+    float echecs[VEHICLE_INDEX_ECHECS][CAPACITE_DIMENSIONS]; // charges qu'aucun véhicule ne prend plus
+    int nbEchecs;
+    int *root;               // arbre de chaque ville (-1 : aucun véhicule)
+    int *left, *right;       // fils de chaque véhicule dans l'arbre de sa ville
+    unsigned int *priority;  // priorités du treap (tas sur les priorités)
+    float *key[CAPACITE_DIMENSIONS];    // capacités restantes (clé de l'arbre : le poids)
+    float *subMax[CAPACITE_DIMENSIONS]; // maximum de chaque dimension dans le sous-arbre
+    int *city;               // ville de chaque véhicule
+    int *cities;             // villes occupées
+    int nbCities;
+    CityCandidates **candidates; // par destination, calculées au premier colis (NULL avant)
+} VehicleIndex;
+
 // >>>>>>>>>> Graphe <<<<<<<<<<<
 Graph *createGraph(int V);
 void addEdge(Graph *graph, int src, int dest, EdgeAttr attr);
 void printGraph(Graph *graph);
 void freeGraph(Graph *graph);
 
+// >>>>>>>>>> Graphe CSR <<<<<<<<<<<
+CSRGraph *buildCSR(Graph *graph);
+const char *csrCityName(const CSRGraph *csr, int v);
+void freeCSR(CSRGraph *csr);
+ReverseCSR *buildReverseCSR(const CSRGraph *csr);
+void freeReverseCSR(ReverseCSR *reverse);
+
+// >>>>>>>>>> Instantané binaire <<<<<<<<<<<
+void *mapFile(const char *filename, size_t *size);
+void unmapFile(void *addr, size_t size);
+bool saveCSRSnapshot(const CSRGraph *csr, const char *filename, const char *sourceFile);
+CSRGraph *openCSRSnapshot(const char *filename, const char *sourceFile, bool verifyChecksum);
+int convertGraphToSnapshot(const char *jsonFile, const char *snapshotFile);
+
 // Function to read a file and return its content
 char *readFile(const char *filename)
 {
@@ -100,6 +640,64 @@ char *readFile(const char *filename)
     return content;
 }
 
+// Fonction pour lire une arête JSON en un seul parcours de ses champs.
+// cJSON_GetObjectItem refait une recherche linéaire (insensible à la casse) par clé ;
+// ici chaque champ n'est visité qu'une fois. Les attributs absents valent 0.
+static bool readEdgeFromJSON(const cJSON *edge, int *src, int *dest, EdgeAttr *attr)
+{
+    bool hasSrc = false, hasDest = false;
+    memset(attr, 0, sizeof(EdgeAttr));
+
+    for (const cJSON *field = edge->child; field; field = field->next)
+    {
+        const char *key = field->string;
+        if (!key || !cJSON_IsNumber(field))
+            continue;
+
+        switch (key[0])
+        {
+        case 's':
+            if (strcmp(key, "src") == 0)
+            {
+                *src = field->valueint;
+                hasSrc = true;
+            }
+            break;
+        case 'd':
+            if (strcmp(key, "dest") == 0)
+            {
+                *dest = field->valueint;
+                hasDest = true;
+            }
+            else if (strcmp(key, "distance") == 0)
+                attr->distance = (float)field->valuedouble;
+            break;
+        case 'b':
+            if (strcmp(key, "baseTime") == 0)
+                attr->baseTime = (float)field->valuedouble;
+            break;
+        case 'c':
+            if (strcmp(key, "cost") == 0)
+                attr->cost = (float)field->valuedouble;
+            break;
+        case 'r':
+            if (strcmp(key, "roadType") == 0)
+                attr->roadType = field->valueint;
+            else if (strcmp(key, "reliability") == 0)
+                attr->reliability = (float)field->valuedouble;
+            else if (strcmp(key, "restrictions") == 0)
+                attr->restrictions = field->valueint;
+            break;
+        case 't':
+            if (strcmp(key, "toll") == 0)
+                attr->toll = field->valueint;
+            break;
+        }
+    }
+
+    return hasSrc && hasDest;
+}
+
 // Function to load a graph from a JSON file
 Graph *loadGraphFromJSON(const char *filename)
 {
@@ -116,8 +714,22 @@ Graph *loadGraphFromJSON(const char *filename)
     }
 
     // Lire le nombre de sommets
-    int V = cJSON_GetObjectItem(json, "vertices")->valueint;
+    cJSON *vertices = cJSON_GetObjectItem(json, "vertices");
+    if (!cJSON_IsNumber(vertices) || vertices->valueint < 0)
+    {
+        printf("Erreur : 'vertices' manquant ou invalide dans le fichier JSON.\n");
+        cJSON_Delete(json);
+        free(jsonData);
+        return NULL;
+    }
+    int V = vertices->valueint;
     Graph *graph = createGraph(V); // No more implicit declaration error
+    if (!graph)
+    {
+        cJSON_Delete(json);
+        free(jsonData);
+        return NULL;
+    }
 
     // Lire les noms des villes
     cJSON *nodes = cJSON_GetObjectItem(json, "nodes");
@@ -142,25 +754,20 @@ Graph *loadGraphFromJSON(const char *filename)
         printf("Erreur : 'nodes' manquant dans le fichier JSON.\n");
     }
 
-    // Lire la liste des arêtes
+    // Lire la liste des arêtes en un seul parcours de la liste chaînée de cJSON
+    // (cJSON_GetArrayItem(edges, i) repartirait du début à chaque arête : O(E²))
     cJSON *edges = cJSON_GetObjectItem(json, "edges");
-    int edgeCount = cJSON_GetArraySize(edges);
-
-    for (int i = 0; i < edgeCount; i++)
+    cJSON *edge;
+    int edgeIndex = 0;
+    cJSON_ArrayForEach(edge, edges)
     {
-        cJSON *edge = cJSON_GetArrayItem(edges, i);
-
-        int src = cJSON_GetObjectItem(edge, "src")->valueint;
-        int dest = cJSON_GetObjectItem(edge, "dest")->valueint;
+        int src = -1, dest = -1;
         EdgeAttr attr;
-        attr.distance = (float)cJSON_GetObjectItem(edge, "distance")->valuedouble;
-        attr.baseTime = (float)cJSON_GetObjectItem(edge, "baseTime")->valuedouble;
-        attr.cost = (float)cJSON_GetObjectItem(edge, "cost")->valuedouble;
-        attr.roadType = cJSON_GetObjectItem(edge, "roadType")->valueint;
-        attr.reliability = (float)cJSON_GetObjectItem(edge, "reliability")->valuedouble;
-        attr.restrictions = cJSON_GetObjectItem(edge, "restrictions")->valueint;
-
-        addEdge(graph, src, dest, attr); // No more implicit declaration error
+        if (readEdgeFromJSON(edge, &src, &dest, &attr))
+            addEdge(graph, src, dest, attr); // No more implicit declaration error
+        else
+            printf("Erreur : arête %d sans 'src' ou 'dest'.\n", edgeIndex);
+        edgeIndex++;
     }
 
     cJSON_Delete(json);
@@ -168,748 +775,9194 @@ Graph *loadGraphFromJSON(const char *filename)
     return graph;
 }
 
-// >>>>>>>>>> DFS <<<<<<<<<<<
-void dfsUtil(Graph *graph, int v, bool *visited);
-void dfs(Graph *graph, int startVertex);
+// Fonction pour écrire un graphe au format de graph.json
+bool saveGraphToJSON(Graph *graph, const char *filename)
+{
+    FILE *file = fopen(filename, "w");
+    if (!file)
+    {
+        printf("Erreur : impossible de créer le fichier %s\n", filename);
+        return false;
+    }
 
-// >>>>>>>>>> BFS <<<<<<<<<<<
-void bfs(Graph *graph, int startVertex);
+    fprintf(file, "{\n  \"vertices\": %d,\n  \"nodes\": {\n", graph->V);
+    for (int i = 0; i < graph->V; i++)
+        fprintf(file, "    \"%d\": \"%s\"%s\n", i, graph->cityNames[i] ? graph->cityNames[i] : "",
+                i + 1 < graph->V ? "," : "");
+    fprintf(file, "  },\n  \"edges\": [\n");
 
-// >>>>>>>>>> Floyd-Warshall <<<<<<<<<<<
-void floydWarshall(Graph *graph, float dist[][graph->V]);
-void printFloydWarshall(Graph *graph, float dist[][graph->V]);
+    bool first = true;
+    for (int u = 0; u < graph->V; u++)
+    {
+        for (AdjListNode *node = graph->array[u].head; node; node = node->next)
+        {
+            fprintf(file, "%s    { \"src\": %d, \"dest\": %d, \"distance\": %.1f, \"baseTime\": %g, "
+                          "\"cost\": %.1f, \"roadType\": %d, \"reliability\": %g, \"restrictions\": %d, \"toll\": %d }",
+                    first ? "" : ",\n", u, node->dest, node->attr.distance, node->attr.baseTime,
+                    node->attr.cost, node->attr.roadType, node->attr.reliability,
+                    node->attr.restrictions, node->attr.toll);
+            first = false;
+        }
+    }
+    fprintf(file, "\n  ]\n}\n");
 
-// >>>>>>>>>> Bellman-Ford <<<<<<<<<<<
-void bellmanFord(Graph *graph, int src, float *dist, int *pred, float maxTime);
-void printBellmanFord(Graph *graph, int src, float *dist, int *pred);
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
 
-// >>>>>>>>>> GLOUTONNE <<<<<<<<<<<
-void affecterColis(Vehicule *vehicules, int nbVehicules, Colis *colis, int nbColis, Carte *carte, Graph *graph);
-void afficherTournees(Vehicule *vehicules, int nbVehicules, Graph *graph);
+// ---------- CHARGEMENT EN FLUX (SAX) ----------
+// Analyseur JSON événementiel : le fichier est lu par blocs de taille fixe et chaque
+// élément (clé, nombre, chaîne, début/fin d'objet ou de tableau) est transmis à un
+// gestionnaire, sans jamais construire l'arbre cJSON en mémoire.
+#define JSON_STREAM_BUFFER 65536 // taille du tampon de lecture
+#define JSON_MAX_DEPTH 64        // profondeur d'imbrication maximale acceptée
 
-// ---------- EXEMPLE DE DONNEES ----------
-void initialiserCarte(Carte *carte)
+typedef enum JSONEvent
 {
-    for (int i = 0; i < MAX_VILLES; i++)
-        for (int j = 0; j < MAX_VILLES; j++)
-            carte->distances[i][j] = (i == j) ? 0 : (rand() % 50 + 1); // distances aléatoires
-}
+    JSON_BEGIN_OBJECT,
+    JSON_END_OBJECT,
+    JSON_BEGIN_ARRAY,
+    JSON_END_ARRAY,
+    JSON_KEY,
+    JSON_STRING,
+    JSON_NUMBER,
+    JSON_LITERAL // true, false ou null (texte dans 'text')
+} JSONEvent;
+
+// Le gestionnaire retourne false pour interrompre l'analyse
+typedef bool (*JSONEventHandler)(void *ctx, JSONEvent event, const char *text, double number);
 
-void chargerColis(Colis *colis, int *nbColis)
+typedef struct JSONStream
 {
-    *nbColis = 20;
-    srand(time(NULL)); // Seed for random number generation
-    for (int i = 0; i < *nbColis; i++)
+    FILE *file;
+    char *buffer; // tampon de lecture (JSON_STREAM_BUFFER octets)
+    size_t pos;
+    size_t len;
+    int line;
+    char *text; // dernière chaîne lue (clé ou valeur)
+    size_t textLen;
+    size_t textCap;
+    JSONEventHandler handler;
+    void *ctx;
+    const char *error;
+} JSONStream;
+
+static int jsonPeek(JSONStream *s)
+{
+    if (s->pos == s->len)
     {
-        colis[i].id = i;
-        colis[i].villeDest = rand() % MAX_VILLES;
-        colis[i].poids = (float)(rand() % 50 + 1);
-        colis[i].volume = (float)(rand() % 20 + 1);
-        colis[i].urgent = rand() % 2;
+        s->len = fread(s->buffer, 1, JSON_STREAM_BUFFER, s->file);
+        s->pos = 0;
+        if (s->len == 0)
+            return EOF;
     }
+    return (unsigned char)s->buffer[s->pos];
 }
 
-void chargerVehicules(Vehicule *vehicules, int *nbVehicules)
+static int jsonNext(JSONStream *s)
 {
-    *nbVehicules = 10;
-    srand(time(NULL)); // Seed for random number generation
-    for (int i = 0; i < *nbVehicules; i++)
+    int c = jsonPeek(s);
+    if (c != EOF)
     {
-        vehicules[i].id = i;
-        vehicules[i].capaciteMax = (float)(rand() % 100 + 1);
-        vehicules[i].capaciteRestante = vehicules[i].capaciteMax;
-        vehicules[i].villeActuelle = rand() % MAX_VILLES;
-        vehicules[i].nbLivraisons = 0;
+        s->pos++;
+        if (c == '\n')
+            s->line++;
     }
+    return c;
 }
 
-// Détection de cycles
-bool detectCycleDFS(Graph *graph, int v, bool *visited, int parent)
+static int jsonSkipSpaces(JSONStream *s)
 {
-    visited[v] = true;
-
-    AdjListNode *node = graph->array[v].head;
-    while (node)
+    int c = jsonPeek(s);
+    while (c == ' ' || c == '\t' || c == '\n' || c == '\r')
     {
-        int neighbor = node->dest;
-        if (!visited[neighbor])
-        {
-            if (detectCycleDFS(graph, neighbor, visited, v))
-                return true;
-        }
-        else if (neighbor != parent)
-        {
-            return true; // Cycle détecté
-        }
-        node = node->next;
+        jsonNext(s);
+        c = jsonPeek(s);
     }
+    return c;
+}
+
+static bool jsonFail(JSONStream *s, const char *error)
+{
+    if (!s->error)
+        s->error = error;
     return false;
 }
 
-bool detectCycles(Graph *graph)
+static bool jsonAppendText(JSONStream *s, char c)
 {
-    bool *visited = malloc(graph->V * sizeof(bool));
-    if (!visited)
+    if (s->textLen + 1 >= s->textCap)
     {
-        printf("Erreur : allocation mémoire échouée pour le tableau 'visited'.\n");
-        return false;
+        size_t cap = s->textCap ? s->textCap * 2 : 64;
+        char *text = (char *)realloc(s->text, cap);
+        if (!text)
+            return jsonFail(s, "allocation mémoire échouée");
+        s->text = text;
+        s->textCap = cap;
     }
+    s->text[s->textLen++] = c;
+    return true;
+}
 
-    for (int i = 0; i < graph->V; i++)
-        visited[i] = false;
+static int jsonHexDigit(int c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
 
-    for (int i = 0; i < graph->V; i++)
+static bool jsonReadHex4(JSONStream *s, unsigned int *code)
+{
+    *code = 0;
+    for (int i = 0; i < 4; i++)
     {
-        if (!visited[i] && detectCycleDFS(graph, i, visited, -1))
-        {
-            free(visited);
-            return true;
-        }
+        int digit = jsonHexDigit(jsonNext(s));
+        if (digit < 0)
+            return jsonFail(s, "séquence \\u invalide");
+        *code = (*code << 4) | (unsigned int)digit;
     }
+    return true;
+}
 
-    free(visited);
-    return false;
+// Encode un point de code en UTF-8 dans le texte courant
+static bool jsonAppendUTF8(JSONStream *s, unsigned int code)
+{
+    if (code < 0x80)
+        return jsonAppendText(s, (char)code);
+    if (code < 0x800)
+        return jsonAppendText(s, (char)(0xC0 | (code >> 6))) &&
+               jsonAppendText(s, (char)(0x80 | (code & 0x3F)));
+    if (code < 0x10000)
+        return jsonAppendText(s, (char)(0xE0 | (code >> 12))) &&
+               jsonAppendText(s, (char)(0x80 | ((code >> 6) & 0x3F))) &&
+               jsonAppendText(s, (char)(0x80 | (code & 0x3F)));
+    return jsonAppendText(s, (char)(0xF0 | (code >> 18))) &&
+           jsonAppendText(s, (char)(0x80 | ((code >> 12) & 0x3F))) &&
+           jsonAppendText(s, (char)(0x80 | ((code >> 6) & 0x3F))) &&
+           jsonAppendText(s, (char)(0x80 | (code & 0x3F)));
 }
 
-// Composantes connexes (BFS)
-void findConnectedComponents(Graph *graph)
+// Lit une chaîne (le guillemet ouvrant est déjà consommé) dans s->text
+static bool jsonReadString(JSONStream *s)
 {
-    bool *visited = malloc(graph->V * sizeof(bool));
-    if (!visited)
+    s->textLen = 0;
+    for (;;)
     {
-        printf("Erreur : allocation mémoire échouée pour le tableau 'visited'.\n");
-        return;
+        int c = jsonNext(s);
+        if (c == EOF)
+            return jsonFail(s, "chaîne non terminée");
+        if (c == '"')
+            break;
+        if (c != '\\')
+        {
+            if (!jsonAppendText(s, (char)c))
+                return false;
+            continue;
+        }
+
+        c = jsonNext(s);
+        unsigned int code;
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            code = (unsigned int)c;
+            break;
+        case 'b':
+            code = '\b';
+            break;
+        case 'f':
+            code = '\f';
+            break;
+        case 'n':
+            code = '\n';
+            break;
+        case 'r':
+            code = '\r';
+            break;
+        case 't':
+            code = '\t';
+            break;
+        case 'u':
+            if (!jsonReadHex4(s, &code))
+                return false;
+            // Paire de substitution UTF-16
+            if (code >= 0xD800 && code <= 0xDBFF)
+            {
+                unsigned int low;
+                if (jsonNext(s) != '\\' || jsonNext(s) != 'u' || !jsonReadHex4(s, &low) ||
+                    low < 0xDC00 || low > 0xDFFF)
+                    return jsonFail(s, "paire de substitution UTF-16 invalide");
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            break;
+        default:
+            return jsonFail(s, "séquence d'échappement invalide");
+        }
+        if (!jsonAppendUTF8(s, code))
+            return false;
     }
+    return jsonAppendText(s, '\0');
+}
 
-    for (int i = 0; i < graph->V; i++)
-        visited[i] = false;
+static bool jsonParseValue(JSONStream *s, int depth);
 
-    int *queue = malloc(graph->V * sizeof(int));
-    if (!queue)
+static bool jsonParseObject(JSONStream *s, int depth)
+{
+    if (!s->handler(s->ctx, JSON_BEGIN_OBJECT, NULL, 0))
+        return jsonFail(s, "analyse interrompue");
+
+    int c = jsonSkipSpaces(s);
+    if (c == '}')
+        jsonNext(s);
+    else
     {
-        printf("Erreur : allocation mémoire échouée pour la file.\n");
-        free(visited);
-        return;
+        for (;;)
+        {
+            if (jsonNext(s) != '"')
+                return jsonFail(s, "clé attendue");
+            if (!jsonReadString(s))
+                return false;
+            if (!s->handler(s->ctx, JSON_KEY, s->text, 0))
+                return jsonFail(s, "analyse interrompue");
+            if (jsonSkipSpaces(s) != ':')
+                return jsonFail(s, "':' attendu");
+            jsonNext(s);
+            if (!jsonParseValue(s, depth + 1))
+                return false;
+
+            c = jsonSkipSpaces(s);
+            jsonNext(s);
+            if (c == '}')
+                break;
+            if (c != ',')
+                return jsonFail(s, "',' ou '}' attendu");
+            jsonSkipSpaces(s);
+        }
     }
 
-    int componentCount = 0;
-    for (int i = 0; i < graph->V; i++)
+    if (!s->handler(s->ctx, JSON_END_OBJECT, NULL, 0))
+        return jsonFail(s, "analyse interrompue");
+    return true;
+}
+
+static bool jsonParseArray(JSONStream *s, int depth)
+{
+    if (!s->handler(s->ctx, JSON_BEGIN_ARRAY, NULL, 0))
+        return jsonFail(s, "analyse interrompue");
+
+    int c = jsonSkipSpaces(s);
+    if (c == ']')
+        jsonNext(s);
+    else
     {
-        if (!visited[i])
+        for (;;)
         {
-            int front = 0, rear = 0;
-            queue[rear++] = i;
-            visited[i] = true;
-            componentCount++;
-
-            printf("Composante %d: ", componentCount);
-            while (front < rear)
-            {
-                int current = queue[front++];
-                printf("%s ", graph->cityNames[current]);
+            if (!jsonParseValue(s, depth + 1))
+                return false;
 
-                AdjListNode *node = graph->array[current].head;
-                while (node)
-                {
-                    if (!visited[node->dest])
-                    {
-                        visited[node->dest] = true;
-                        queue[rear++] = node->dest;
-                    }
-                    node = node->next;
-                }
-            }
-            printf("\n");
+            c = jsonSkipSpaces(s);
+            jsonNext(s);
+            if (c == ']')
+                break;
+            if (c != ',')
+                return jsonFail(s, "',' ou ']' attendu");
         }
     }
 
-    printf("Total: %d composantes\n", componentCount);
-    free(queue);
-    free(visited);
+    if (!s->handler(s->ctx, JSON_END_ARRAY, NULL, 0))
+        return jsonFail(s, "analyse interrompue");
+    return true;
 }
 
-// Accessibilité entre deux nœuds
-bool isAccessible(Graph *graph, int src, int dest)
+static bool jsonParseValue(JSONStream *s, int depth)
 {
-    if (src < 0 || src >= graph->V || dest < 0 || dest >= graph->V)
+    if (depth > JSON_MAX_DEPTH)
+        return jsonFail(s, "imbrication trop profonde");
+
+    int c = jsonSkipSpaces(s);
+    if (c == '{')
     {
-        printf("Erreur : sommets source ou destination invalides.\n");
-        return false;
+        jsonNext(s);
+        return jsonParseObject(s, depth);
     }
-
-    bool *visited = malloc(graph->V * sizeof(bool));
-    if (!visited)
+    if (c == '[')
+    {
+        jsonNext(s);
+        return jsonParseArray(s, depth);
+    }
+    if (c == '"')
+    {
+        jsonNext(s);
+        if (!jsonReadString(s))
+            return false;
+        if (!s->handler(s->ctx, JSON_STRING, s->text, 0))
+            return jsonFail(s, "analyse interrompue");
+        return true;
+    }
+    if (c == '-' || (c >= '0' && c <= '9'))
+    {
+        char number[64];
+        size_t n = 0;
+        while (c != EOF && (c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E' || (c >= '0' && c <= '9')))
+        {
+            if (n + 1 >= sizeof(number))
+                return jsonFail(s, "nombre trop long");
+            number[n++] = (char)jsonNext(s);
+            c = jsonPeek(s);
+        }
+        number[n] = '\0';
+
+        char *end;
+        double value = strtod(number, &end);
+        if (*end != '\0')
+            return jsonFail(s, "nombre invalide");
+        if (!s->handler(s->ctx, JSON_NUMBER, number, value))
+            return jsonFail(s, "analyse interrompue");
+        return true;
+    }
+    if (c == 't' || c == 'f' || c == 'n')
+    {
+        const char *literal = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+        for (const char *p = literal; *p; p++)
+        {
+            if (jsonNext(s) != *p)
+                return jsonFail(s, "littéral invalide");
+        }
+        if (!s->handler(s->ctx, JSON_LITERAL, literal, 0))
+            return jsonFail(s, "analyse interrompue");
+        return true;
+    }
+    return jsonFail(s, c == EOF ? "fin de fichier inattendue" : "valeur attendue");
+}
+
+// Fonction pour analyser un fichier JSON en flux ; retourne false en cas d'erreur
+bool parseJSONStream(const char *filename, JSONEventHandler handler, void *ctx)
+{
+    JSONStream s = {0};
+    s.file = fopen(filename, "rb");
+    if (!s.file)
+    {
+        fprintf(stderr, "Erreur : impossible d'ouvrir le fichier %s\n", filename);
+        return false;
+    }
+    s.buffer = (char *)malloc(JSON_STREAM_BUFFER);
+    if (!s.buffer)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour le tampon de lecture.\n");
+        fclose(s.file);
+        return false;
+    }
+    s.line = 1;
+    s.handler = handler;
+    s.ctx = ctx;
+
+    bool ok = jsonParseValue(&s, 0);
+    if (ok && jsonSkipSpaces(&s) != EOF)
+        ok = jsonFail(&s, "contenu après la fin du document");
+    if (!ok)
+        fprintf(stderr, "Erreur JSON (%s, ligne %d) : %s\n", filename, s.line, s.error);
+
+    free(s.text);
+    free(s.buffer);
+    fclose(s.file);
+    return ok;
+}
+
+// Arête lue avant que le nombre de sommets ne soit connu
+typedef struct PendingEdge
+{
+    int src;
+    int dest;
+    EdgeAttr attr;
+} PendingEdge;
+
+// Sections du schéma graph.json (clés de premier niveau)
+enum
+{
+    SECTION_AUTRE,
+    SECTION_VERTICES,
+    SECTION_NODES,
+    SECTION_EDGES
+};
+
+// État du constructeur de graphe alimenté par les événements JSON
+typedef struct GraphStreamBuilder
+{
+    Graph *graph;
+    int depth;
+    int section;
+    int nodeIndex;    // clé courante dans "nodes"
+    char field[16];   // champ courant d'une arête
+    int src;          // arête en cours de lecture
+    int dest;
+    bool hasSrc;
+    bool hasDest;
+    EdgeAttr attr;
+    int edgeIndex;
+    // Noms et arêtes rencontrés avant "vertices" (ordre des clés non garanti en JSON)
+    PendingEdge *pendingEdges;
+    int nbPendingEdges;
+    int capPendingEdges;
+    char **pendingNames;
+    int *pendingNameIndex;
+    int nbPendingNames;
+    int capPendingNames;
+} GraphStreamBuilder;
+
+static void builderSetName(Graph *graph, int index, char *name)
+{
+    if (index >= 0 && index < graph->V)
+    {
+        free(graph->cityNames[index]);
+        graph->cityNames[index] = name;
+    }
+    else
+    {
+        fprintf(stderr, "Erreur : index de ville invalide (%d).\n", index);
+        free(name);
+    }
+}
+
+static bool builderAddName(GraphStreamBuilder *b, const char *value)
+{
+    char *name = strdup(value);
+    if (!name)
+        return false;
+    if (b->graph)
+    {
+        builderSetName(b->graph, b->nodeIndex, name);
+        return true;
+    }
+
+    if (b->nbPendingNames == b->capPendingNames)
+    {
+        int cap = b->capPendingNames ? b->capPendingNames * 2 : 64;
+        char **names = (char **)realloc(b->pendingNames, cap * sizeof(char *));
+        if (names)
+            b->pendingNames = names;
+        int *indexes = (int *)realloc(b->pendingNameIndex, cap * sizeof(int));
+        if (indexes)
+            b->pendingNameIndex = indexes;
+        if (!names || !indexes)
+        {
+            free(name);
+            return false;
+        }
+        b->capPendingNames = cap;
+    }
+    b->pendingNames[b->nbPendingNames] = name;
+    b->pendingNameIndex[b->nbPendingNames++] = b->nodeIndex;
+    return true;
+}
+
+static bool builderAddEdge(GraphStreamBuilder *b)
+{
+    if (!b->hasSrc || !b->hasDest)
+    {
+        fprintf(stderr, "Erreur : arête %d sans 'src' ou 'dest'.\n", b->edgeIndex);
+        return true;
+    }
+    if (b->graph)
+    {
+        addEdge(b->graph, b->src, b->dest, b->attr);
+        return true;
+    }
+
+    if (b->nbPendingEdges == b->capPendingEdges)
+    {
+        int cap = b->capPendingEdges ? b->capPendingEdges * 2 : 1024;
+        PendingEdge *edges = (PendingEdge *)realloc(b->pendingEdges, cap * sizeof(PendingEdge));
+        if (!edges)
+            return false;
+        b->pendingEdges = edges;
+        b->capPendingEdges = cap;
+    }
+    PendingEdge *pending = &b->pendingEdges[b->nbPendingEdges++];
+    pending->src = b->src;
+    pending->dest = b->dest;
+    pending->attr = b->attr;
+    return true;
+}
+
+// Création du graphe dès que "vertices" est lu, puis report des données en attente
+static bool builderCreateGraph(GraphStreamBuilder *b, double vertices)
+{
+    if (b->graph || vertices < 0 || vertices > 2147483647.0)
+    {
+        fprintf(stderr, "Erreur : 'vertices' dupliqué ou invalide dans le fichier JSON.\n");
+        return false;
+    }
+    b->graph = createGraph((int)vertices);
+    if (!b->graph)
+        return false;
+
+    for (int i = 0; i < b->nbPendingNames; i++)
+        builderSetName(b->graph, b->pendingNameIndex[i], b->pendingNames[i]);
+    for (int i = 0; i < b->nbPendingEdges; i++)
+        addEdge(b->graph, b->pendingEdges[i].src, b->pendingEdges[i].dest, b->pendingEdges[i].attr);
+
+    free(b->pendingNames);
+    free(b->pendingNameIndex);
+    free(b->pendingEdges);
+    b->pendingNames = NULL;
+    b->pendingNameIndex = NULL;
+    b->pendingEdges = NULL;
+    b->nbPendingNames = b->nbPendingEdges = 0;
+    return true;
+}
+
+static void builderSetField(GraphStreamBuilder *b, const char *key, double value)
+{
+    if (strcmp(key, "src") == 0)
+    {
+        b->src = (int)value;
+        b->hasSrc = true;
+    }
+    else if (strcmp(key, "dest") == 0)
+    {
+        b->dest = (int)value;
+        b->hasDest = true;
+    }
+    else if (strcmp(key, "distance") == 0)
+        b->attr.distance = (float)value;
+    else if (strcmp(key, "baseTime") == 0)
+        b->attr.baseTime = (float)value;
+    else if (strcmp(key, "cost") == 0)
+        b->attr.cost = (float)value;
+    else if (strcmp(key, "roadType") == 0)
+        b->attr.roadType = (int)value;
+    else if (strcmp(key, "reliability") == 0)
+        b->attr.reliability = (float)value;
+    else if (strcmp(key, "restrictions") == 0)
+        b->attr.restrictions = (int)value;
+    else if (strcmp(key, "toll") == 0)
+        b->attr.toll = (int)value;
+}
+
+// Gestionnaire d'événements pour le schéma { "vertices", "nodes": {..}, "edges": [..] }
+static bool graphStreamHandler(void *ctx, JSONEvent event, const char *text, double number)
+{
+    GraphStreamBuilder *b = (GraphStreamBuilder *)ctx;
+
+    switch (event)
+    {
+    case JSON_BEGIN_OBJECT:
+    case JSON_BEGIN_ARRAY:
+        b->depth++;
+        if (event == JSON_BEGIN_OBJECT && b->depth == 3 && b->section == SECTION_EDGES)
+        {
+            b->hasSrc = b->hasDest = false;
+            memset(&b->attr, 0, sizeof(EdgeAttr));
+            b->field[0] = '\0';
+        }
+        return true;
+
+    case JSON_END_OBJECT:
+    case JSON_END_ARRAY:
+        if (event == JSON_END_OBJECT && b->depth == 3 && b->section == SECTION_EDGES)
+        {
+            if (!builderAddEdge(b))
+                return false;
+            b->edgeIndex++;
+        }
+        b->depth--;
+        if (b->depth == 1)
+            b->section = SECTION_AUTRE;
+        return true;
+
+    case JSON_KEY:
+        if (b->depth == 1)
+        {
+            b->section = strcmp(text, "vertices") == 0 ? SECTION_VERTICES
+                         : strcmp(text, "nodes") == 0  ? SECTION_NODES
+                         : strcmp(text, "edges") == 0  ? SECTION_EDGES
+                                                       : SECTION_AUTRE;
+        }
+        else if (b->depth == 2 && b->section == SECTION_NODES)
+            b->nodeIndex = atoi(text);
+        else if (b->depth == 3 && b->section == SECTION_EDGES)
+        {
+            if (strlen(text) < sizeof(b->field))
+                strcpy(b->field, text);
+            else
+                b->field[0] = '\0';
+        }
+        return true;
+
+    case JSON_NUMBER:
+        if (b->depth == 1 && b->section == SECTION_VERTICES)
+            return builderCreateGraph(b, number);
+        if (b->depth == 3 && b->section == SECTION_EDGES)
+            builderSetField(b, b->field, number);
+        return true;
+
+    case JSON_STRING:
+        if (b->depth == 2 && b->section == SECTION_NODES)
+            return builderAddName(b, text);
+        return true;
+
+    case JSON_LITERAL:
+        return true;
+    }
+    return true;
+}
+
+// Fonction pour charger un graphe depuis un fichier JSON en flux :
+// la mémoire utilisée est celle du graphe plus un tampon de lecture de taille fixe.
+Graph *loadGraphFromJSONStream(const char *filename)
+{
+    GraphStreamBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+
+    bool ok = parseJSONStream(filename, graphStreamHandler, &builder);
+    if (ok && !builder.graph)
+    {
+        fprintf(stderr, "Erreur : 'vertices' manquant dans le fichier JSON.\n");
+        ok = false;
+    }
+
+    for (int i = 0; i < builder.nbPendingNames; i++)
+        free(builder.pendingNames[i]);
+    free(builder.pendingNames);
+    free(builder.pendingNameIndex);
+    free(builder.pendingEdges);
+
+    if (!ok)
+    {
+        if (builder.graph)
+            freeGraph(builder.graph);
+        return NULL;
+    }
+    return builder.graph;
+}
+
+// >>>>>>>>>> DFS <<<<<<<<<<<
+DFSEngine *createDFSEngine(int V);
+void freeDFSEngine(DFSEngine *engine);
+void dfsEngineReset(DFSEngine *engine);
+bool dfsEngineVisited(const DFSEngine *engine, int v);
+bool dfsEngineRun(DFSEngine *engine, const CSRGraph *csr, int root, const DFSVisitor *visitor);
+void dfs(Graph *graph, int startVertex);
+void dfsCSR(const CSRGraph *csr, int startVertex);
+bool topologicalOrderCSR(const CSRGraph *csr, int *order);
+
+// >>>>>>>>>> BFS <<<<<<<<<<<
+void bfs(Graph *graph, int startVertex);
+void bfsCSR(const CSRGraph *csr, int startVertex);
+BFSTree *createBFSTree(int V);
+void freeBFSTree(BFSTree *tree);
+int bfsDirectionOptimizing(const CSRGraph *csr, const ReverseCSR *reverse, BFSTree *tree, int src);
+ReachQuery *createReachQuery(int V);
+void freeReachQuery(ReachQuery *query);
+bool isAccessibleBidirectional(const CSRGraph *csr, const ReverseCSR *reverse, ReachQuery *query, int src, int dest);
+
+// >>>>>>>>>> Index d'accessibilité <<<<<<<<<<<
+ReachabilityIndex *buildReachabilityIndex(const CSRGraph *csr);
+void freeReachabilityIndex(ReachabilityIndex *index);
+bool isAccessibleIndexed(const ReachabilityIndex *index, int src, int dest);
+void addEdgeIndexed(Graph *graph, ReachabilityIndex *index, int src, int dest, EdgeAttr attr);
+
+// >>>>>>>>>> Floyd-Warshall <<<<<<<<<<<
+DistMatrix *createDistMatrix(int n);
+void freeDistMatrix(DistMatrix *matrix);
+float *distMatrixRow(const DistMatrix *matrix, int i);
+void floydWarshall(Graph *graph, DistMatrix *dist);
+void printFloydWarshall(Graph *graph, const DistMatrix *dist);
+void floydWarshallCSR(const CSRGraph *csr, DistMatrix *dist);
+void printFloydWarshallCSR(const CSRGraph *csr, const DistMatrix *dist);
+void floydWarshallInitCSR(const CSRGraph *csr, DistMatrix *dist);
+void floydWarshallBlocked(float *dist, int V, int ld, FWKernel kernel);
+void floydWarshallParallel(float *dist, int V, int ld, FWKernel kernel, int nbThreads);
+int nombreThreadsMax(void);
+FWKernel floydWarshallResolveKernel(FWKernel kernel);
+const char *floydWarshallKernelName(FWKernel kernel);
+
+// >>>>>>>>>> Bellman-Ford <<<<<<<<<<<
+void bellmanFord(Graph *graph, int src, float *dist, int *pred, float maxTime);
+void printBellmanFord(Graph *graph, int src, float *dist, int *pred);
+void bellmanFordCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime);
+void printBellmanFordCSR(const CSRGraph *csr, int src, float *dist, int *pred);
+bool spfaCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime);
+void printShortestPathsCSR(const CSRGraph *csr, int src, float *dist, int *pred, const char *algorithm);
+MultiSourcePaths *createMultiSourcePaths(int V, int K);
+void freeMultiSourcePaths(MultiSourcePaths *paths);
+bool bellmanFordBatchCSR(const CSRGraph *csr, const int *sources, float maxTime, MultiSourcePaths *paths);
+void multiSourceColumn(const MultiSourcePaths *paths, int s, float *dist, int *pred);
+
+// >>>>>>>>>> Dijkstra <<<<<<<<<<<
+IndexedHeap *createIndexedHeap(int capacity);
+void freeIndexedHeap(IndexedHeap *heap);
+void heapClear(IndexedHeap *heap);
+void heapPushOrDecrease(IndexedHeap *heap, int v, float key);
+int heapPopMin(IndexedHeap *heap);
+bool hasNegativeWeights(const CSRGraph *csr);
+void dijkstraCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime);
+const char *shortestPathModeName(ShortestPathMode mode);
+ShortestPathMode shortestPathsCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime, ShortestPathMode mode);
+
+// >>>>>>>>>> Plus court chemin sous contrainte de ressource <<<<<<<<<<<
+RCSPLabels *createRCSPLabels(int V);
+void freeRCSPLabels(RCSPLabels *labels);
+bool rcspCSR(const CSRGraph *csr, int src, int target, float maxTime, RCSPLabels *labels);
+int rcspPath(const RCSPLabels *labels, int v, int *path);
+void printResourceConstrainedPathsCSR(const CSRGraph *csr, int src, const RCSPLabels *labels);
+
+// >>>>>>>>>> Hiérarchie de contraction <<<<<<<<<<<
+const float *routeMetricColumn(const CSRGraph *csr, RouteMetric metric);
+const char *routeMetricName(RouteMetric metric);
+CHGraph *buildContractionHierarchy(const CSRGraph *csr, RouteMetric metric);
+void freeContractionHierarchy(CHGraph *ch);
+bool saveContractionHierarchy(const CHGraph *ch, const char *filename);
+CHGraph *loadContractionHierarchy(const char *filename, const CSRGraph *csr, RouteMetric metric);
+CHGraph *openContractionHierarchy(const CSRGraph *csr, RouteMetric metric, const char *filename);
+CHQuery *createCHQuery(int V);
+void freeCHQuery(CHQuery *query);
+float chQuery(const CHGraph *ch, CHQuery *query, int s, int t, int *path, int *pathLength);
+
+// >>>>>>>>>> A* / repères (ALT) <<<<<<<<<<<
+LandmarkIndex *buildLandmarkIndex(const CSRGraph *csr, const ReverseCSR *reverse, RouteMetric metric, int K);
+void freeLandmarkIndex(LandmarkIndex *alt);
+AStarQuery *createAStarQuery(int V);
+void freeAStarQuery(AStarQuery *query);
+float astarQuery(const CSRGraph *csr, const LandmarkIndex *alt, RouteMetric metric, AStarQuery *query, int s, int t,
+                 int *path, int *pathLength);
+
+// >>>>>>>>>> Benchmarks <<<<<<<<<<<
+double chronometre(void);
+Graph *genererGrapheAleatoire(int V, int E, unsigned int seed);
+Graph *genererGrilleRoutiere(int largeur, int hauteur, unsigned int seed);
+Graph *genererChaineRoutiere(int N, bool boucle, unsigned int seed);
+int lancerBenchmark(int argc, char *argv[]);
+
+// >>>>>>>>>> GLOUTONNE <<<<<<<<<<<
+bool initialiserCarte(Carte *carte, const CSRGraph *csr, RouteMetric metric);
+void libererCarte(Carte *carte);
+const float *carteLigne(Carte *carte, int origine);
+float carteDistance(Carte *carte, int origine, int destination);
+void *arenaAlloc(Arena *arena, size_t size);
+void arenaRelease(Arena *arena);
+void initialiserLotColis(LotColis *lot);
+void libererLotColis(LotColis *lot);
+int ajouterColis(LotColis *lot, int villeDest, const float *charge, int urgent);
+void initialiserFlotte(Flotte *flotte);
+void libererFlotte(Flotte *flotte);
+int ajouterVehicule(Flotte *flotte, const float *capaciteMax, int villeActuelle);
+bool ajouterLivraison(Flotte *flotte, int vehicule, int ville);
+void viderTournees(Flotte *flotte);
+void initialiserFileColis(FileColis *file);
+void libererFileColis(FileColis *file);
+int classeColis(const LotColis *lot, int colis);
+bool fileColisAjouter(FileColis *file, const LotColis *lot, int colis);
+int fileColisExtraire(FileColis *file);
+int vehiculesCompatibles(const Flotte *flotte, const float *charge, int *liste, FWKernel kernel);
+float resteApresCharge(const Flotte *flotte, int vehicule, const float *charge);
+VehicleIndex *createVehicleIndex(const Flotte *flotte, int V, const float *chargeMin, ModeAffectation mode);
+void freeVehicleIndex(VehicleIndex *index);
+int vehicleIndexBest(VehicleIndex *index, Carte *carte, int destination, const float *charge, float *distance);
+void vehicleIndexUpdate(VehicleIndex *index, int vehicule);
+int meilleurVehiculeParcours(const Flotte *flotte, Carte *carte, int destination, const float *charge,
+                             ModeAffectation mode, FWKernel kernel, int *liste, float *distance);
+int affecterColisIndexe(Flotte *flotte, const LotColis *colis, ModeAffectation mode, Carte *carte, int *affectation,
+                        float *distance);
+int affecterColisFile(Flotte *flotte, const LotColis *colis, FileColis *file, ModeAffectation mode, Carte *carte,
+                      int *ordre, int *affectation, float *distance);
+void affecterColis(Flotte *flotte, const LotColis *colis, ModeAffectation mode, Carte *carte, const CSRGraph *csr);
+void afficherTournees(const Flotte *flotte, const CSRGraph *csr);
+
+// ---------- EXEMPLE DE DONNEES ----------
+bool chargerColis(LotColis *colis)
+{
+    srand(time(NULL)); // Seed for random number generation
+    for (int i = 0; i < 20; i++)
+    {
+        int villeDest = rand() % MAX_VILLES;
+        float charge[CAPACITE_DIMENSIONS];
+        charge[DIM_POIDS] = (float)(rand() % 50 + 1);
+        charge[DIM_VOLUME] = (float)(rand() % 20 + 1);
+        if (ajouterColis(colis, villeDest, charge, rand() % 2) < 0)
+            return false;
+    }
+    return true;
+}
+
+bool chargerVehicules(Flotte *flotte)
+{
+    srand(time(NULL)); // Seed for random number generation
+    for (int i = 0; i < 10; i++)
+    {
+        float capaciteMax[CAPACITE_DIMENSIONS];
+        capaciteMax[DIM_POIDS] = (float)(rand() % 100 + 1);
+        capaciteMax[DIM_VOLUME] = (float)(rand() % 40 + 1);
+        if (ajouterVehicule(flotte, capaciteMax, rand() % MAX_VILLES) < 0)
+            return false;
+    }
+    return true;
+}
+
+// Algorithme de Tarjan : rappels du moteur de parcours (voir TarjanState)
+static bool tarjanPreVisit(void *context, int v, int parent)
+{
+    TarjanState *state = (TarjanState *)context;
+    (void)parent;
+    state->order[v] = state->low[v] = state->counter++;
+    state->stack[state->top++] = v;
+    state->onStack[v] = true;
+    return true;
+}
+
+static bool tarjanNonTreeEdge(void *context, int u, int v, int parent, DFSEdgeKind kind)
+{
+    TarjanState *state = (TarjanState *)context;
+    (void)parent;
+    (void)kind;
+    if (state->onStack[v] && state->order[v] < state->low[u])
+        state->low[u] = state->order[v];
+    return true;
+}
+
+// Tous les arcs de u sont vus : u ferme une composante s'il en est la racine
+static bool tarjanPostVisit(void *context, int u, int parent)
+{
+    TarjanState *state = (TarjanState *)context;
+    if (state->low[u] == state->order[u])
+    {
+        int w;
+        do
+        {
+            w = state->stack[--state->top];
+            state->onStack[w] = false;
+            state->component[w] = state->C;
+        } while (w != u);
+        state->C++;
+    }
+    if (parent >= 0 && state->low[u] < state->low[parent])
+        state->low[parent] = state->low[u];
+    return true;
+}
+
+// Composantes fortement connexes par l'algorithme de Tarjan, sur le moteur de parcours à
+// pile explicite (sans récursion). Les composantes sont numérotées dans l'ordre où
+// elles se ferment, c'est-à-dire en ordre topologique inverse du DAG de condensation :
+// un arc entre composantes va toujours d'un numéro plus grand vers un plus petit.
+// Retourne le nombre de composantes, -1 si la mémoire manque.
+static int tarjanSCC(const CSRGraph *csr, int *component)
+{
+    int V = csr->V;
+    TarjanState state = {component, NULL, NULL, NULL, NULL, 0, 0, 0};
+    state.order = (int *)malloc(V * sizeof(int));
+    state.low = (int *)malloc(V * sizeof(int));
+    state.stack = (int *)malloc(V * sizeof(int));
+    state.onStack = (bool *)calloc(V, sizeof(bool));
+    DFSEngine *engine = createDFSEngine(V);
+    int C = -1;
+    if (state.order && state.low && state.stack && state.onStack && engine)
+    {
+        DFSVisitor visitor = {tarjanPreVisit, tarjanPostVisit, tarjanNonTreeEdge, &state};
+        for (int root = 0; root < V; root++)
+            dfsEngineRun(engine, csr, root, &visitor);
+        C = state.C;
+    }
+
+    freeDFSEngine(engine);
+    free(state.order);
+    free(state.low);
+    free(state.stack);
+    free(state.onStack);
+    return C;
+}
+
+// Détection de cycles par le moteur de parcours à pile explicite. En mode orienté, un
+// circuit existe si et seulement si le parcours rencontre un arc arrière (cible grise,
+// encore sur le chemin courant). En mode non orienté, tout voisin déjà visité autre que
+// le parent signale un cycle.
+static bool cycleNonTreeEdge(void *context, int u, int v, int parent, DFSEdgeKind kind)
+{
+    CycleMode mode = *(const CycleMode *)context;
+    (void)u;
+    if (mode == CYCLE_DIRECTED ? kind != DFS_BACK_EDGE : v == parent)
+        return true;
+    return false; // Cycle détecté : on arrête le parcours
+}
+
+bool detectCyclesCSR(const CSRGraph *csr, CycleMode mode)
+{
+    DFSEngine *engine = createDFSEngine(csr->V);
+    if (!engine)
+        return false;
+
+    bool found = false;
+    DFSVisitor visitor = {NULL, NULL, cycleNonTreeEdge, &mode};
+    for (int i = 0; i < csr->V && !found; i++)
+        found = !dfsEngineRun(engine, csr, i, &visitor);
+
+    freeDFSEngine(engine);
+    return found;
+}
+
+bool detectCycles(Graph *graph, CycleMode mode)
+{
+    CSRGraph *csr = buildCSR(graph);
+    if (!csr)
+        return false;
+    bool found = detectCyclesCSR(csr, mode);
+    freeCSR(csr);
+    return found;
+}
+
+static bool cyclePreVisit(void *context, int v, int parent)
+{
+    CycleState *state = (CycleState *)context;
+    state->parent[v] = parent;
+    return tarjanPreVisit(&state->tarjan, v, parent);
+}
+
+static bool cyclePostVisit(void *context, int v, int parent)
+{
+    return tarjanPostVisit(&((CycleState *)context)->tarjan, v, parent);
+}
+
+static bool cycleReportNonTreeEdge(void *context, int u, int v, int parent, DFSEdgeKind kind)
+{
+    CycleState *state = (CycleState *)context;
+    if (kind == DFS_BACK_EDGE)
+    {
+        if (u == v)
+            state->selfLoop[u] = true;
+        if (state->backSource < 0)
+        {
+            state->backSource = u;
+            state->backTarget = v;
+        }
+    }
+    return tarjanNonTreeEdge(&state->tarjan, u, v, parent, kind);
+}
+
+void freeCycleReport(CycleReport *report)
+{
+    if (!report)
+        return;
+    free(report->memberOffsets);
+    free(report->memberList);
+    free(report->cycle);
+    free(report);
+}
+
+// Recense les circuits du graphe orienté en un seul parcours en profondeur (O(V + E)) :
+// CFC de Tarjan, boucles, et un circuit exemple reconstruit depuis le premier arc arrière
+// en remontant l'arbre du parcours. Retourne NULL si la mémoire manque.
+CycleReport *findCyclesCSR(const CSRGraph *csr)
+{
+    int V = csr->V;
+    CycleReport *report = (CycleReport *)calloc(1, sizeof(CycleReport));
+    CycleState state = {{NULL, NULL, NULL, NULL, NULL, 0, 0, 0}, NULL, NULL, -1, -1};
+    state.tarjan.component = (int *)malloc(V * sizeof(int));
+    state.tarjan.order = (int *)malloc(V * sizeof(int));
+    state.tarjan.low = (int *)malloc(V * sizeof(int));
+    state.tarjan.stack = (int *)malloc(V * sizeof(int));
+    state.tarjan.onStack = (bool *)calloc(V, sizeof(bool));
+    state.parent = (int *)malloc(V * sizeof(int));
+    state.selfLoop = (bool *)calloc(V, sizeof(bool));
+    DFSEngine *engine = createDFSEngine(V);
+    bool ok = report && state.tarjan.component && state.tarjan.order && state.tarjan.low && state.tarjan.stack &&
+              state.tarjan.onStack && state.parent && state.selfLoop && engine;
+    int *size = NULL, *slot = NULL;
+
+    if (ok)
+    {
+        report->V = V;
+        DFSVisitor visitor = {cyclePreVisit, cyclePostVisit, cycleReportNonTreeEdge, &state};
+        for (int root = 0; root < V; root++)
+            dfsEngineRun(engine, csr, root, &visitor);
+
+        // CFC cycliques : plus d'un sommet, ou une boucle sur leur unique sommet
+        int C = state.tarjan.C;
+        size = (int *)calloc(C, sizeof(int));
+        slot = (int *)malloc(C * sizeof(int));
+        ok = size && slot;
+        for (int v = 0; ok && v < V; v++)
+            size[state.tarjan.component[v]]++;
+        for (int c = 0; ok && c < C; c++)
+            slot[c] = -1;
+        for (int v = 0; ok && v < V; v++)
+        {
+            int c = state.tarjan.component[v];
+            if (slot[c] < 0 && (size[c] > 1 || state.selfLoop[v]))
+            {
+                slot[c] = report->components++;
+                report->members += size[c];
+            }
+        }
+    }
+
+    if (ok)
+    {
+        // Regroupement des sommets par CFC cyclique (tri par dénombrement)
+        report->memberOffsets = (int *)calloc(report->components + 1, sizeof(int));
+        report->memberList = (int *)malloc((report->members > 0 ? report->members : 1) * sizeof(int));
+        report->cycle = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+        ok = report->memberOffsets && report->memberList && report->cycle;
+    }
+    if (ok)
+    {
+        for (int v = 0; v < V; v++)
+        {
+            int k = slot[state.tarjan.component[v]];
+            if (k >= 0)
+                report->memberOffsets[k + 1]++;
+        }
+        for (int k = 0; k < report->components; k++)
+            report->memberOffsets[k + 1] += report->memberOffsets[k];
+        int *fill = state.tarjan.order; // réutilisé comme curseurs d'insertion
+        for (int k = 0; k < report->components; k++)
+            fill[k] = report->memberOffsets[k];
+        for (int v = 0; v < V; v++)
+        {
+            int k = slot[state.tarjan.component[v]];
+            if (k >= 0)
+                report->memberList[fill[k]++] = v;
+        }
+
+        // Circuit exemple : backTarget -> ... -> backSource le long de l'arbre, puis l'arc arrière
+        if (state.backSource >= 0)
+        {
+            int n = 0;
+            for (int w = state.backSource; w != state.backTarget; w = state.parent[w])
+                report->cycle[n++] = w;
+            report->cycle[n++] = state.backTarget;
+            for (int i = 0; i < n / 2; i++)
+            {
+                int tmp = report->cycle[i];
+                report->cycle[i] = report->cycle[n - 1 - i];
+                report->cycle[n - 1 - i] = tmp;
+            }
+            report->cycleLength = n;
+        }
+    }
+
+    if (!ok)
+    {
+        printf("Erreur : allocation mémoire échouée pour la recherche de circuits.\n");
+        freeCycleReport(report);
+        report = NULL;
+    }
+    free(size);
+    free(slot);
+    freeDFSEngine(engine);
+    free(state.tarjan.component);
+    free(state.tarjan.order);
+    free(state.tarjan.low);
+    free(state.tarjan.stack);
+    free(state.tarjan.onStack);
+    free(state.parent);
+    free(state.selfLoop);
+    return report;
+}
+
+// Écrit le bilan des circuits dans buffer (au plus size octets, terminé par '\0'), en listant
+// au plus maxListed villes par CFC. Comme snprintf, retourne la longueur complète du texte :
+// si elle dépasse size - 1, le texte a été tronqué.
+size_t formatCycleReport(const CSRGraph *csr, const CycleReport *report, char *buffer, size_t size, int maxListed)
+{
+    size_t length = 0;
+#define CYCLE_APPEND(...)                                                                             \
+    do                                                                                                \
+    {                                                                                                 \
+        int n = snprintf(buffer && length < size ? buffer + length : NULL,                            \
+                         buffer && length < size ? size - length : 0, __VA_ARGS__);                   \
+        if (n > 0)                                                                                    \
+            length += (size_t)n;                                                                      \
+    } while (0)
+
+    if (buffer && size > 0)
+        buffer[0] = '\0';
+    if (report->components == 0)
+    {
+        CYCLE_APPEND("Aucun circuit orienté.\n");
+        return length;
+    }
+
+    CYCLE_APPEND("%d composante(s) fortement connexe(s) avec circuit, %d ville(s) concernée(s)\n", report->components,
+                 report->members);
+    if (report->cycleLength > 0)
+    {
+        CYCLE_APPEND("Exemple de circuit :");
+        for (int i = 0; i < report->cycleLength; i++)
+            CYCLE_APPEND(" %s ->", csrCityName(csr, report->cycle[i]));
+        CYCLE_APPEND(" %s\n", csrCityName(csr, report->cycle[0]));
+    }
+    for (int k = 0; k < report->components; k++)
+    {
+        int first = report->memberOffsets[k], count = report->memberOffsets[k + 1] - first;
+        CYCLE_APPEND("  CFC %d (%d ville(s)) :", k + 1, count);
+        for (int i = 0; i < count && i < maxListed; i++)
+            CYCLE_APPEND(" %s", csrCityName(csr, report->memberList[first + i]));
+        if (count > maxListed)
+            CYCLE_APPEND(" ... (+%d)", count - maxListed);
+        CYCLE_APPEND("\n");
+    }
+#undef CYCLE_APPEND
+    return length;
+}
+
+void printCycleReport(const CSRGraph *csr, const CycleReport *report)
+{
+    size_t length = formatCycleReport(csr, report, NULL, 0, 20);
+    char *text = (char *)malloc(length + 1);
+    if (!text)
+    {
+        printf("Erreur : allocation mémoire échouée pour le bilan des circuits.\n");
+        return;
+    }
+    formatCycleReport(csr, report, text, length + 1, 20);
+    fputs(text, stdout);
+    free(text);
+}
+
+// Composantes connexes (BFS)
+void findConnectedComponents(Graph *graph)
+{
+    bool *visited = malloc(graph->V * sizeof(bool));
+    if (!visited)
     {
         printf("Erreur : allocation mémoire échouée pour le tableau 'visited'.\n");
+        return;
+    }
+
+    for (int i = 0; i < graph->V; i++)
+        visited[i] = false;
+
+    int *queue = malloc(graph->V * sizeof(int));
+    if (!queue)
+    {
+        printf("Erreur : allocation mémoire échouée pour la file.\n");
+        free(visited);
+        return;
+    }
+
+    int componentCount = 0;
+    for (int i = 0; i < graph->V; i++)
+    {
+        if (!visited[i])
+        {
+            int front = 0, rear = 0;
+            queue[rear++] = i;
+            visited[i] = true;
+            componentCount++;
+
+            printf("Composante %d: ", componentCount);
+            while (front < rear)
+            {
+                int current = queue[front++];
+                printf("%s ", graph->cityNames[current]);
+
+                AdjListNode *node = graph->array[current].head;
+                while (node)
+                {
+                    if (!visited[node->dest])
+                    {
+                        visited[node->dest] = true;
+                        queue[rear++] = node->dest;
+                    }
+                    node = node->next;
+                }
+            }
+            printf("\n");
+        }
+    }
+
+    printf("Total: %d composantes\n", componentCount);
+    free(queue);
+    free(visited);
+}
+
+// Parcours en largeur des composantes en suivant les arcs sortants, racines prises dans
+// l'ordre des numéros : label[v] reçoit le numéro de composante (0, 1, ... dans l'ordre du
+// plus petit sommet), queue l'ordre de visite des V sommets. Retourne le nombre de composantes.
+int labelConnectedComponentsCSR(const CSRGraph *csr, int *label, int *queue)
+{
+    for (int v = 0; v < csr->V; v++)
+        label[v] = -1;
+
+    int componentCount = 0, rear = 0;
+    for (int i = 0; i < csr->V; i++)
+    {
+        if (label[i] >= 0)
+            continue;
+        int front = rear;
+        queue[rear++] = i;
+        label[i] = componentCount;
+        while (front < rear)
+        {
+            int current = queue[front++];
+            for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++)
+            {
+                int v = csr->dest[e];
+                if (label[v] < 0)
+                {
+                    label[v] = componentCount;
+                    queue[rear++] = v;
+                }
+            }
+        }
+        componentCount++;
+    }
+    return componentCount;
+}
+
+void findConnectedComponentsCSR(const CSRGraph *csr)
+{
+    int *label = malloc((csr->V > 0 ? csr->V : 1) * sizeof(int));
+    int *queue = malloc((csr->V > 0 ? csr->V : 1) * sizeof(int));
+    if (!label || !queue)
+    {
+        printf("Erreur : allocation mémoire échouée pour le parcours des composantes.\n");
+        free(label);
+        free(queue);
+        return;
+    }
+
+    int componentCount = labelConnectedComponentsCSR(csr, label, queue);
+    for (int k = 0; k < csr->V; k++)
+    {
+        int current = queue[k];
+        if (k == 0 || label[current] != label[queue[k - 1]])
+            printf("%sComposante %d: ", k == 0 ? "" : "\n", label[current] + 1);
+        printf("%s ", csrCityName(csr, current));
+    }
+    if (csr->V > 0)
+        printf("\n");
+
+    printf("Total: %d composantes\n", componentCount);
+    free(queue);
+    free(label);
+}
+
+// Lecture, écriture et compare-and-swap atomiques sur le tableau des parents de l'union-find
+static inline int ufLoad(int *p)
+{
+#if defined(__GNUC__)
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+#else
+    return *p;
+#endif
+}
+
+static inline void ufStore(int *p, int value)
+{
+#if defined(__GNUC__)
+    __atomic_store_n(p, value, __ATOMIC_RELAXED);
+#else
+    *p = value;
+#endif
+}
+
+static inline bool ufCompareAndSwap(int *p, int expected, int desired)
+{
+#if defined(__GNUC__)
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#else
+    if (*p != expected)
+        return false;
+    *p = desired;
+    return true;
+#endif
+}
+
+// Réunit les arbres de u et v : la racine de plus grand numéro est accrochée à l'autre par
+// compare-and-swap ; en cas de conflit avec un autre thread, on remonte et on recommence.
+// La racine d'une composante est donc toujours son plus petit sommet.
+static void ufLink(int *parent, int u, int v)
+{
+    int p1 = ufLoad(&parent[u]), p2 = ufLoad(&parent[v]);
+    while (p1 != p2)
+    {
+        int high = p1 > p2 ? p1 : p2, low = p1 + p2 - high;
+        int pHigh = ufLoad(&parent[high]);
+        if (pHigh == low || (pHigh == high && ufCompareAndSwap(&parent[high], high, low)))
+            break;
+        p1 = ufLoad(&parent[ufLoad(&parent[high])]);
+        p2 = ufLoad(&parent[low]);
+    }
+}
+
+// Aplatit les arbres : chaque sommet pointe directement sur sa racine
+static void ufCompress(int *parent, int V, int nbThreads)
+{
+    (void)nbThreads;
+    OMP_PRAGMA(omp parallel for schedule(static) num_threads(nbThreads))
+    for (int v = 0; v < V; v++)
+    {
+        int p = ufLoad(&parent[v]);
+        while (p != ufLoad(&parent[p]))
+            p = ufLoad(&parent[p]);
+        ufStore(&parent[v], p);
+    }
+}
+
+static int compareInts(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+void freeComponentLabels(ComponentLabels *components)
+{
+    if (!components)
+        return;
+    free(components->label);
+    free(components->size);
+    free(components);
+}
+
+// Composantes connexes par union-find parallèle (schéma Afforest) : chaque sommet est
+// d'abord lié à ses UF_NEIGHBOR_ROUNDS premiers voisins, ce qui fait apparaître la
+// composante géante ; on la repère par échantillonnage, puis seuls les sommets hors de
+// cette composante traitent leurs arcs restants. Ce raccourci suppose que chaque arc est
+// vu par ses deux extrémités : il n'est pris que si reverse (arcs entrants) est fourni,
+// sinon tous les arcs restants sont traités. nbThreads <= 0 : tous les cœurs disponibles.
+ComponentLabels *connectedComponentsUnionFind(const CSRGraph *csr, const ReverseCSR *reverse, int nbThreads)
+{
+    int V = csr->V;
+    ComponentLabels *components = (ComponentLabels *)calloc(1, sizeof(ComponentLabels));
+    int *parent = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    if (components)
+        components->label = parent;
+    if (!components || !parent)
+    {
+        printf("Erreur : allocation mémoire échouée pour l'union-find.\n");
+        freeComponentLabels(components);
+        return NULL;
+    }
+    components->V = V;
+#if defined(__GNUC__)
+    if (nbThreads <= 0)
+        nbThreads = nombreThreadsMax();
+#else
+    nbThreads = 1; // pas de compare-and-swap portable : exécution séquentielle
+#endif
+
+    OMP_PRAGMA(omp parallel for schedule(static) num_threads(nbThreads))
+    for (int v = 0; v < V; v++)
+        parent[v] = v;
+
+    // Premières passes : un arc par sommet et par tour
+    for (int r = 0; r < UF_NEIGHBOR_ROUNDS; r++)
+    {
+        OMP_PRAGMA(omp parallel for schedule(dynamic, 1024) num_threads(nbThreads))
+        for (int u = 0; u < V; u++)
+            if (csr->offsets[u] + r < csr->offsets[u + 1])
+                ufLink(parent, u, csr->dest[csr->offsets[u] + r]);
+        ufCompress(parent, V, nbThreads);
+    }
+
+    // Composante la plus fréquente dans un échantillon de sommets
+    int skip = -1;
+    if (reverse && V > 0)
+    {
+        int samples[UF_SAMPLES];
+        unsigned int etat = 2463534242u;
+        for (int i = 0; i < UF_SAMPLES; i++)
+        {
+            etat ^= etat << 13;
+            etat ^= etat >> 17;
+            etat ^= etat << 5;
+            samples[i] = parent[etat % V];
+        }
+        qsort(samples, UF_SAMPLES, sizeof(int), compareInts);
+        int best = 0;
+        for (int i = 0, j; i < UF_SAMPLES; i = j)
+        {
+            for (j = i; j < UF_SAMPLES && samples[j] == samples[i]; j++)
+                ;
+            if (j - i > best)
+            {
+                best = j - i;
+                skip = samples[i];
+            }
+        }
+    }
+
+    // Arcs restants (et arcs entrants si reverse), sauf pour les sommets de la composante géante
+    OMP_PRAGMA(omp parallel for schedule(dynamic, 1024) num_threads(nbThreads))
+    for (int u = 0; u < V; u++)
+    {
+        if (skip >= 0 && ufLoad(&parent[u]) == skip)
+            continue;
+        for (int e = csr->offsets[u] + UF_NEIGHBOR_ROUNDS; e < csr->offsets[u + 1]; e++)
+            ufLink(parent, u, csr->dest[e]);
+        if (reverse)
+            for (int e = reverse->offsets[u]; e < reverse->offsets[u + 1]; e++)
+                ufLink(parent, u, reverse->source[e]);
+    }
+    ufCompress(parent, V, nbThreads);
+
+    // Numérotation dense : la racine (plus petit sommet) de chaque composante est vue en
+    // premier, les composantes sont donc numérotées dans l'ordre de leur plus petit sommet
+    int count = 0;
+    for (int v = 0; v < V; v++)
+        parent[v] = parent[v] == v ? -1 - count++ : parent[v];
+    for (int v = 0; v < V; v++)
+        parent[v] = parent[v] < 0 ? -1 - parent[v] : parent[parent[v]];
+    components->count = count;
+    components->size = (int *)calloc(count > 0 ? count : 1, sizeof(int));
+    if (!components->size)
+    {
+        printf("Erreur : allocation mémoire échouée pour l'union-find.\n");
+        freeComponentLabels(components);
+        return NULL;
+    }
+    for (int v = 0; v < V; v++)
+        components->size[parent[v]]++;
+    return components;
+}
+
+// Accessibilité entre deux nœuds
+bool isAccessible(Graph *graph, int src, int dest)
+{
+    if (src < 0 || src >= graph->V || dest < 0 || dest >= graph->V)
+    {
+        printf("Erreur : sommets source ou destination invalides.\n");
+        return false;
+    }
+
+    bool *visited = malloc(graph->V * sizeof(bool));
+    if (!visited)
+    {
+        printf("Erreur : allocation mémoire échouée pour le tableau 'visited'.\n");
+        return false;
+    }
+
+    for (int i = 0; i < graph->V; i++)
+        visited[i] = false;
+
+    int *queue = malloc(graph->V * sizeof(int));
+    if (!queue)
+    {
+        printf("Erreur : allocation mémoire échouée pour la file.\n");
+        free(visited);
+        return false;
+    }
+
+    int front = 0, rear = 0;
+    queue[rear++] = src;
+    visited[src] = true;
+
+    while (front < rear)
+    {
+        int current = queue[front++];
+        if (current == dest)
+        {
+            free(queue);
+            free(visited);
+            return true;
+        }
+
+        AdjListNode *node = graph->array[current].head;
+        while (node)
+        {
+            if (!visited[node->dest])
+            {
+                visited[node->dest] = true;
+                queue[rear++] = node->dest;
+            }
+            node = node->next;
+        }
+    }
+
+    free(queue);
+    free(visited);
+    return false;
+}
+
+bool isAccessibleCSR(const CSRGraph *csr, int src, int dest)
+{
+    if (src < 0 || src >= csr->V || dest < 0 || dest >= csr->V)
+    {
+        printf("Erreur : sommets source ou destination invalides.\n");
+        return false;
+    }
+
+    bool *visited = calloc(csr->V, sizeof(bool));
+    int *queue = malloc(csr->V * sizeof(int));
+    if (!visited || !queue)
+    {
+        printf("Erreur : allocation mémoire échouée pour le parcours.\n");
+        free(visited);
+        free(queue);
+        return false;
+    }
+
+    bool found = false;
+    int front = 0, rear = 0;
+    queue[rear++] = src;
+    visited[src] = true;
+
+    while (front < rear && !found)
+    {
+        int current = queue[front++];
+        if (current == dest)
+        {
+            found = true;
+            break;
+        }
+
+        for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++)
+        {
+            int v = csr->dest[e];
+            if (!visited[v])
+            {
+                visited[v] = true;
+                queue[rear++] = v;
+            }
+        }
+    }
+
+    free(queue);
+    free(visited);
+    return found;
+}
+
+// Accessibilité par BFS bidirectionnel : tampons d'une requête, réutilisés d'un appel à l'autre
+ReachQuery *createReachQuery(int V)
+{
+    ReachQuery *query = (ReachQuery *)calloc(1, sizeof(ReachQuery));
+    bool ok = query != NULL;
+    for (int d = 0; ok && d < 2; d++)
+    {
+        query->stamp[d] = (unsigned int *)calloc(V, sizeof(unsigned int));
+        query->queue[d] = (int *)malloc(V * sizeof(int));
+        ok = query->stamp[d] && query->queue[d];
+    }
+    if (!ok)
+    {
+        printf("Erreur : allocation mémoire échouée pour le parcours.\n");
+        freeReachQuery(query);
+        return NULL;
+    }
+    query->V = V;
+    return query;
+}
+
+void freeReachQuery(ReachQuery *query)
+{
+    if (!query)
+        return;
+    for (int d = 0; d < 2; d++)
+    {
+        free(query->stamp[d]);
+        free(query->queue[d]);
+    }
+    free(query);
+}
+
+// Fonction pour vérifier si dest est accessible depuis src par un BFS bidirectionnel :
+// en avant depuis src sur le CSR, en arrière depuis dest sur l'index inverse. À chaque
+// étape, on développe un niveau entier du côté dont la frontière est la plus petite ; les
+// deux recherches s'arrêtent dès qu'elles se touchent, ou dès que l'une s'épuise.
+bool isAccessibleBidirectional(const CSRGraph *csr, const ReverseCSR *reverse, ReachQuery *query, int src, int dest)
+{
+    if (src < 0 || src >= csr->V || dest < 0 || dest >= csr->V)
+    {
+        printf("Erreur : sommets source ou destination invalides.\n");
+        return false;
+    }
+    query->visited = 1;
+    if (src == dest)
+        return true;
+
+    if (++query->generation == 0)
+    {
+        memset(query->stamp[0], 0, query->V * sizeof(unsigned int));
+        memset(query->stamp[1], 0, query->V * sizeof(unsigned int));
+        query->generation = 1;
+    }
+    unsigned int gen = query->generation;
+    query->stamp[0][src] = gen;
+    query->stamp[1][dest] = gen;
+    query->queue[0][0] = src;
+    query->queue[1][0] = dest;
+    query->visited = 2;
+    int front[2] = {0, 0}, rear[2] = {1, 1};
+
+    while (front[0] < rear[0] && front[1] < rear[1])
+    {
+        int d = rear[0] - front[0] <= rear[1] - front[1] ? 0 : 1;
+        const int *offsets = d == 0 ? csr->offsets : reverse->offsets;
+        const int *adj = d == 0 ? csr->dest : reverse->source;
+        unsigned int *mine = query->stamp[d], *other = query->stamp[1 - d];
+        int *queue = query->queue[d];
+
+        int end = rear[d];
+        while (front[d] < end)
+        {
+            int u = queue[front[d]++];
+            for (int i = offsets[u]; i < offsets[u + 1]; i++)
+            {
+                int v = adj[i];
+                if (other[v] == gen)
+                    return true;
+                if (mine[v] != gen)
+                {
+                    mine[v] = gen;
+                    queue[rear[d]++] = v;
+                    query->visited++;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> INDEX D'ACCESSIBILITE (CFC + FERMETURE TRANSITIVE PAR INTERVALLES)
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Remplace dst par l'union de dst et src (listes triées, intervalles contigus fusionnés)
+static bool intervalListUnion(IntervalList *dst, const IntervalList *src)
+{
+    if (src->count == 0)
+        return true;
+    int *bounds = (int *)malloc(2 * (dst->count + src->count) * sizeof(int));
+    if (!bounds)
+        return false;
+
+    int i = 0, j = 0, n = 0;
+    while (i < dst->count || j < src->count)
+    {
+        const int *next;
+        if (j >= src->count || (i < dst->count && dst->bounds[2 * i] <= src->bounds[2 * j]))
+            next = dst->bounds + 2 * i++;
+        else
+            next = src->bounds + 2 * j++;
+
+        if (n > 0 && next[0] <= bounds[2 * n - 1] + 1)
+        {
+            if (next[1] > bounds[2 * n - 1])
+                bounds[2 * n - 1] = next[1];
+        }
+        else
+        {
+            bounds[2 * n] = next[0];
+            bounds[2 * n + 1] = next[1];
+            n++;
+        }
+    }
+
+    int *shrunk = (int *)realloc(bounds, 2 * n * sizeof(int));
+    free(dst->bounds);
+    dst->bounds = shrunk ? shrunk : bounds;
+    dst->count = n;
+    return true;
+}
+
+// Recherche dichotomique de x dans une liste d'intervalles : O(log k)
+static bool intervalListContains(const IntervalList *list, int x)
+{
+    int lo = 0, hi = list->count - 1;
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (x < list->bounds[2 * mid])
+            hi = mid - 1;
+        else if (x > list->bounds[2 * mid + 1])
+            lo = mid + 1;
+        else
+            return true;
+    }
+    return false;
+}
+
+// Vérifie que chaque intervalle de sub est contenu dans un intervalle de list
+static bool intervalListIncludes(const IntervalList *list, const IntervalList *sub)
+{
+    int j = 0;
+    for (int i = 0; i < sub->count; i++)
+    {
+        while (j < list->count && list->bounds[2 * j + 1] < sub->bounds[2 * i])
+            j++;
+        if (j == list->count || list->bounds[2 * j] > sub->bounds[2 * i] || list->bounds[2 * j + 1] < sub->bounds[2 * i + 1])
+            return false;
+    }
+    return true;
+}
+
+void freeReachabilityIndex(ReachabilityIndex *index)
+{
+    if (!index)
+        return;
+    for (int c = 0; index->labels && c < index->C; c++)
+        free(index->labels[c].bounds);
+    free(index->labels);
+    free(index->component);
+    free(index->dagOffsets);
+    free(index->dagDest);
+    free(index->post);
+    free(index);
+}
+
+// Fonction pour construire l'index d'accessibilité du graphe, en temps linéaire pour les
+// CFC et le DAG, puis proportionnel à la taille des étiquettes pour la fermeture.
+ReachabilityIndex *buildReachabilityIndex(const CSRGraph *csr)
+{
+    int V = csr->V;
+    ReachabilityIndex *index = (ReachabilityIndex *)calloc(1, sizeof(ReachabilityIndex));
+    if (!index)
+    {
+        printf("Erreur : allocation mémoire échouée pour l'index d'accessibilité.\n");
+        return NULL;
+    }
+    index->V = V;
+    index->component = (int *)malloc(V * sizeof(int));
+    int C = index->component ? tarjanSCC(csr, index->component) : -1;
+    if (C < 0)
+    {
+        printf("Erreur : allocation mémoire échouée pour l'index d'accessibilité.\n");
+        freeReachabilityIndex(index);
+        return NULL;
+    }
+    index->C = C;
+
+    // Sommets regroupés par composante (tri par dénombrement)
+    int *start = (int *)calloc(C + 1, sizeof(int));
+    int *members = (int *)malloc(V * sizeof(int));
+    int *mark = (int *)malloc(C * sizeof(int)); // dernier arc de composante vu (dédoublonnage)
+    int *iter = (int *)malloc(C * sizeof(int));
+    int *stack = (int *)malloc(C * sizeof(int));
+    int *lowPost = (int *)malloc(C * sizeof(int));
+    index->dagOffsets = (int *)calloc(C + 1, sizeof(int));
+    index->post = (int *)malloc(C * sizeof(int));
+    index->labels = (IntervalList *)calloc(C, sizeof(IntervalList));
+    bool ok = start && members && mark && iter && stack && lowPost && index->dagOffsets && index->post && index->labels;
+
+    if (ok)
+    {
+        for (int v = 0; v < V; v++)
+            start[index->component[v] + 1]++;
+        for (int c = 0; c < C; c++)
+            start[c + 1] += start[c];
+        for (int v = 0; v < V; v++)
+            members[start[index->component[v]]++] = v;
+        for (int c = C; c > 0; c--)
+            start[c] = start[c - 1];
+        start[0] = 0;
+
+        // DAG de condensation en deux passes (comptage puis remplissage), sans doublon
+        for (int pass = 0; pass < 2 && ok; pass++)
+        {
+            for (int c = 0; c < C; c++)
+                mark[c] = -1;
+            for (int c = 0; c < C; c++)
+            {
+                int fill = index->dagOffsets[c];
+                for (int m = start[c]; m < start[c + 1]; m++)
+                {
+                    int u = members[m];
+                    for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+                    {
+                        int d = index->component[csr->dest[e]];
+                        if (d == c || mark[d] == c)
+                            continue;
+                        mark[d] = c;
+                        if (pass == 0)
+                            index->dagOffsets[c + 1]++;
+                        else
+                            index->dagDest[fill++] = d;
+                    }
+                }
+            }
+            if (pass == 0)
+            {
+                for (int c = 0; c < C; c++)
+                    index->dagOffsets[c + 1] += index->dagOffsets[c];
+                index->dagDest = (int *)malloc((index->dagOffsets[C] ? index->dagOffsets[C] : 1) * sizeof(int));
+                ok = index->dagDest != NULL;
+            }
+        }
+    }
+
+    if (ok)
+    {
+        // Forêt couvrante du DAG, parcourue en profondeur depuis les sources (numéros les
+        // plus grands d'abord) : le sous-arbre de c reçoit les numéros [lowPost[c], post[c]]
+        for (int c = 0; c < C; c++)
+            iter[c] = -1;
+        int counter = 0;
+        for (int root = C - 1; root >= 0; root--)
+        {
+            if (iter[root] >= 0)
+                continue;
+            int depth = 0;
+            stack[depth++] = root;
+            iter[root] = index->dagOffsets[root];
+            lowPost[root] = counter;
+            while (depth > 0)
+            {
+                int c = stack[depth - 1];
+                if (iter[c] < index->dagOffsets[c + 1])
+                {
+                    int d = index->dagDest[iter[c]++];
+                    if (iter[d] < 0)
+                    {
+                        iter[d] = index->dagOffsets[d];
+                        lowPost[d] = counter;
+                        stack[depth++] = d;
+                    }
+                    continue;
+                }
+                index->post[c] = counter++;
+                depth--;
+            }
+        }
+
+        // Étiquettes : les successeurs ont des numéros de composante plus petits, leurs
+        // étiquettes sont donc complètes quand on traite c
+        for (int c = 0; c < C && ok; c++)
+        {
+            IntervalList *label = &index->labels[c];
+            label->bounds = (int *)malloc(2 * sizeof(int));
+            ok = label->bounds != NULL;
+            if (!ok)
+                break;
+            label->bounds[0] = lowPost[c];
+            label->bounds[1] = index->post[c];
+            label->count = 1;
+            for (int i = index->dagOffsets[c]; i < index->dagOffsets[c + 1] && ok; i++)
+                ok = intervalListUnion(label, &index->labels[index->dagDest[i]]);
+            index->intervals += label->count;
+        }
+    }
+
+    free(start);
+    free(members);
+    free(mark);
+    free(iter);
+    free(stack);
+    free(lowPost);
+    if (!ok)
+    {
+        printf("Erreur : allocation mémoire échouée pour l'index d'accessibilité.\n");
+        freeReachabilityIndex(index);
+        return NULL;
+    }
+    return index;
+}
+
+// Fonction pour vérifier si dest est accessible depuis src à l'aide de l'index : O(1) si
+// les deux villes sont dans la même composante, O(log k) sinon (k intervalles de src)
+bool isAccessibleIndexed(const ReachabilityIndex *index, int src, int dest)
+{
+    if (src < 0 || src >= index->V || dest < 0 || dest >= index->V)
+    {
+        printf("Erreur : sommets source ou destination invalides.\n");
+        return false;
+    }
+    int cs = index->component[src], cd = index->component[dest];
+    return cs == cd || intervalListContains(&index->labels[cs], index->post[cd]);
+}
+
+// Fusionne les composantes que la nouvelle route cs -> cd place sur un même cycle : celles
+// qu'atteint cd et qui atteignent cs. Les étiquettes sont déjà à jour (toutes ces composantes
+// atteignent cs, donc tout ce qui les atteint contient post[cs]) : cs représente le groupe,
+// les autres numéros sont supprimés et le DAG est recompacté. O(V + C + arcs du DAG).
+static bool reachabilityMerge(ReachabilityIndex *index, int cs, int cd)
+{
+    int C = index->C;
+    int *newId = (int *)malloc(C * sizeof(int));
+    int *mark = (int *)malloc(C * sizeof(int));
+    if (!newId || !mark)
+    {
+        free(newId);
+        free(mark);
+        return false;
+    }
+
+    // Numérotation compacte : les composantes fusionnées prennent le numéro de cs
+    int next = 0;
+    for (int c = 0; c < C; c++)
+    {
+        bool merged = c != cs && intervalListContains(&index->labels[cd], index->post[c]) &&
+                      intervalListContains(&index->labels[c], index->post[cs]);
+        newId[c] = merged ? -1 : next++;
+    }
+    for (int c = 0; c < C; c++)
+    {
+        if (newId[c] < 0)
+        {
+            newId[c] = newId[cs];
+            index->intervals -= index->labels[c].count;
+            free(index->labels[c].bounds);
+            continue;
+        }
+        index->labels[newId[c]] = index->labels[c];
+        index->post[newId[c]] = index->post[c];
+    }
+    for (int v = 0; v < index->V; v++)
+        index->component[v] = newId[index->component[v]];
+
+    // DAG recompacté : arcs renumérotés, arcs internes au groupe et doublons retirés
+    int *offsets = (int *)calloc(next + 1, sizeof(int));
+    int *dest = (int *)malloc((index->dagOffsets[C] ? index->dagOffsets[C] : 1) * sizeof(int));
+    if (!offsets || !dest)
+    {
+        free(offsets);
+        free(dest);
+        free(newId);
+        free(mark);
+        return false;
+    }
+    for (int c = 0; c < C; c++)
+        offsets[newId[c] + 1] += index->dagOffsets[c + 1] - index->dagOffsets[c];
+    for (int c = 0; c < next; c++)
+        offsets[c + 1] += offsets[c];
+    int *fill = mark; // curseur de remplissage, puis marque de dédoublonnage
+    for (int c = 0; c < next; c++)
+        fill[c] = offsets[c];
+    for (int c = 0; c < C; c++)
+    {
+        for (int i = index->dagOffsets[c]; i < index->dagOffsets[c + 1]; i++)
+            dest[fill[newId[c]]++] = newId[index->dagDest[i]];
+    }
+    for (int c = 0; c < next; c++)
+        mark[c] = -1;
+    int count = 0;
+    for (int c = 0; c < next; c++)
+    {
+        int first = offsets[c], last = offsets[c + 1];
+        offsets[c] = count;
+        for (int i = first; i < last; i++)
+        {
+            if (dest[i] == c || mark[dest[i]] == c)
+                continue;
+            mark[dest[i]] = c;
+            dest[count++] = dest[i];
+        }
+    }
+    offsets[next] = count;
+
+    free(index->dagOffsets);
+    free(index->dagDest);
+    index->dagOffsets = offsets;
+    index->dagDest = dest;
+    index->C = next;
+    free(newId);
+    free(mark);
+    return true;
+}
+
+// Fonction pour ajouter une route au graphe en tenant l'index à jour (index peut être NULL).
+// Si dest était déjà accessible depuis src, rien ne change. Sinon, chaque composante qui
+// atteint src hérite de l'étiquette de dest ; puis, si src était accessible depuis dest, la
+// route ferme un cycle et les composantes concernées fusionnent, sinon l'arc est ajouté au
+// DAG de condensation. Coût O(C log k) (+ O(V) en cas de fusion) au lieu d'une reconstruction.
+void addEdgeIndexed(Graph *graph, ReachabilityIndex *index, int src, int dest, EdgeAttr attr)
+{
+    addEdge(graph, src, dest, attr);
+    if (!index || src < 0 || src >= graph->V || dest < 0 || dest >= graph->V || isAccessibleIndexed(index, src, dest))
+        return;
+
+    bool cycle = isAccessibleIndexed(index, dest, src);
+    int cs = index->component[src], cd = index->component[dest];
+    for (int c = 0; c < index->C; c++)
+    {
+        // cd n'est modifiée que si elle atteint cs (cycle), et alors par sa propre étiquette
+        if (c != cd && (c == cs || intervalListContains(&index->labels[c], index->post[cs])) &&
+            !intervalListIncludes(&index->labels[c], &index->labels[cd]))
+        {
+            index->intervals -= index->labels[c].count;
+            if (!intervalListUnion(&index->labels[c], &index->labels[cd]))
+                printf("Erreur : allocation mémoire échouée pour l'index d'accessibilité.\n");
+            index->intervals += index->labels[c].count;
+        }
+    }
+
+    if (cycle)
+    {
+        if (!reachabilityMerge(index, cs, cd))
+            printf("Erreur : allocation mémoire échouée pour l'index d'accessibilité.\n");
+        return;
+    }
+
+    // Nouvel arc cs -> cd du DAG, inséré à la fin des arcs de cs
+    int *dagDest = (int *)realloc(index->dagDest, (index->dagOffsets[index->C] + 1) * sizeof(int));
+    if (!dagDest)
+    {
+        printf("Erreur : allocation mémoire échouée pour le DAG de condensation.\n");
+        return;
+    }
+    index->dagDest = dagDest;
+    int at = index->dagOffsets[cs + 1];
+    memmove(dagDest + at + 1, dagDest + at, (index->dagOffsets[index->C] - at) * sizeof(int));
+    dagDest[at] = cd;
+    for (int c = cs + 1; c <= index->C; c++)
+        index->dagOffsets[c]++;
+}
+
+// Statistiques de connectivité
+static void attrStatsInit(AttrStats *attr)
+{
+    attr->min = FLT_MAX;
+    attr->max = -FLT_MAX;
+    attr->sum = 0.0;
+}
+
+static inline void attrStatsAdd(AttrStats *attr, float value)
+{
+    if (value < attr->min)
+        attr->min = value;
+    if (value > attr->max)
+        attr->max = value;
+    attr->sum += value;
+}
+
+static void attrStatsMerge(AttrStats *dst, const AttrStats *src)
+{
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+    dst->sum += src->sum;
+}
+
+static void graphStatsInit(GraphStats *stats)
+{
+    memset(stats, 0, sizeof(GraphStats));
+    stats->minOutDegree = stats->minInDegree = INT32_MAX;
+    attrStatsInit(&stats->distance);
+    attrStatsInit(&stats->baseTime);
+    attrStatsInit(&stats->cost);
+    attrStatsInit(&stats->reliability);
+    attrStatsInit(&stats->toll);
+}
+
+// Cumule les compteurs de la passe sur les arcs (partie d'un thread) dans dst
+static void graphStatsMerge(GraphStats *dst, const GraphStats *src)
+{
+    if (src->minOutDegree < dst->minOutDegree)
+        dst->minOutDegree = src->minOutDegree;
+    if (src->maxOutDegree > dst->maxOutDegree)
+        dst->maxOutDegree = src->maxOutDegree;
+    if (src->minInDegree < dst->minInDegree)
+        dst->minInDegree = src->minInDegree;
+    if (src->maxInDegree > dst->maxInDegree)
+        dst->maxInDegree = src->maxInDegree;
+    for (int i = 0; i < STATS_DEGREE_BUCKETS; i++)
+    {
+        dst->outDegreeHistogram[i] += src->outDegreeHistogram[i];
+        dst->inDegreeHistogram[i] += src->inDegreeHistogram[i];
+    }
+    attrStatsMerge(&dst->distance, &src->distance);
+    attrStatsMerge(&dst->baseTime, &src->baseTime);
+    attrStatsMerge(&dst->cost, &src->cost);
+    attrStatsMerge(&dst->reliability, &src->reliability);
+    attrStatsMerge(&dst->toll, &src->toll);
+    for (int i = 0; i < STATS_ROAD_TYPES; i++)
+        dst->roadTypes[i] += src->roadTypes[i];
+    dst->tollEdges += src->tollEdges;
+    dst->restrictedEdges += src->restrictedEdges;
+}
+
+// Diamètre estimé : le plus grand niveau atteint par bfsSamples parcours en largeur. Les
+// sources alternent entre un sommet tiré au hasard et le sommet le plus éloigné trouvé par
+// le parcours précédent (double balayage), ce qui donne une borne inférieure serrée sur
+// les réseaux routiers.
+static int sampledDiameter(const CSRGraph *csr, const ReverseCSR *reverse, int bfsSamples)
+{
+    BFSTree *tree = bfsSamples > 0 && csr->V > 0 ? createBFSTree(csr->V) : NULL;
+    if (!tree)
+        return 0;
+
+    int diameter = 0, farthest = 0;
+    unsigned int etat = 88172645u;
+    for (int k = 0; k < bfsSamples; k++)
+    {
+        etat ^= etat << 13;
+        etat ^= etat >> 17;
+        etat ^= etat << 5;
+        int src = k % 2 == 0 ? (int)(etat % csr->V) : farthest;
+        bfsDirectionOptimizing(csr, reverse, tree, src);
+        if (tree->depth > diameter)
+            diameter = tree->depth;
+        for (int v = 0; v < csr->V; v++)
+            if (tree->level[v] == tree->depth)
+            {
+                farthest = v;
+                break;
+            }
+    }
+    freeBFSTree(tree);
+    return diameter;
+}
+
+// Statistiques du réseau en une passe sur les arcs : les sommets sont répartis par blocs
+// entre les threads, chacun cumule ses propres compteurs, fusionnés à la fin. Les degrés
+// entrants viennent de reverse s'il est fourni, sinon d'un comptage atomique pendant la
+// passe. bfsSamples parcours en largeur estiment le diamètre (0 : pas d'estimation).
+bool calculateConnectivityStatsCSR(const CSRGraph *csr, const ReverseCSR *reverse, int bfsSamples, GraphStats *stats)
+{
+    double t0 = chronometre();
+    int V = csr->V;
+    int *inDegree = reverse ? NULL : (int *)calloc(V > 0 ? V : 1, sizeof(int));
+    if (!reverse && !inDegree)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour les statistiques.\n");
+        return false;
+    }
+
+    graphStatsInit(stats);
+    stats->V = V;
+    stats->E = csr->E;
+
+    OMP_PRAGMA(omp parallel)
+    {
+        GraphStats local;
+        graphStatsInit(&local);
+
+        OMP_PRAGMA(omp for schedule(static) nowait)
+        for (int u = 0; u < V; u++)
+        {
+            int degree = csr->offsets[u + 1] - csr->offsets[u];
+            if (degree < local.minOutDegree)
+                local.minOutDegree = degree;
+            if (degree > local.maxOutDegree)
+                local.maxOutDegree = degree;
+            local.outDegreeHistogram[degree < STATS_DEGREE_BUCKETS ? degree : STATS_DEGREE_BUCKETS - 1]++;
+
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+            {
+                attrStatsAdd(&local.distance, csr->distance[e]);
+                attrStatsAdd(&local.baseTime, csr->baseTime[e]);
+                attrStatsAdd(&local.cost, csr->cost[e]);
+                attrStatsAdd(&local.reliability, csr->reliability[e]);
+                attrStatsAdd(&local.toll, (float)csr->toll[e]);
+                int type = csr->roadType[e];
+                local.roadTypes[type >= 0 && type < STATS_ROAD_TYPES - 1 ? type : STATS_ROAD_TYPES - 1]++;
+                local.tollEdges += csr->toll[e] > 0;
+                local.restrictedEdges += csr->restrictions[e] != 0;
+                if (inDegree)
+                {
+                    OMP_PRAGMA(omp atomic)
+                    inDegree[csr->dest[e]]++;
+                }
+            }
+        }
+
+        // Degrés entrants, une fois tous les arcs comptés
+        OMP_PRAGMA(omp barrier)
+        OMP_PRAGMA(omp for schedule(static) nowait)
+        for (int v = 0; v < V; v++)
+        {
+            int degree = reverse ? reverse->offsets[v + 1] - reverse->offsets[v] : inDegree[v];
+            if (degree < local.minInDegree)
+                local.minInDegree = degree;
+            if (degree > local.maxInDegree)
+                local.maxInDegree = degree;
+            local.inDegreeHistogram[degree < STATS_DEGREE_BUCKETS ? degree : STATS_DEGREE_BUCKETS - 1]++;
+        }
+
+        OMP_PRAGMA(omp critical)
+        graphStatsMerge(stats, &local);
+    }
+    free(inDegree);
+
+    // Valeurs neutres pour un graphe sans sommet ou sans arc
+    if (V == 0)
+        stats->minOutDegree = stats->minInDegree = 0;
+    if (csr->E == 0)
+    {
+        AttrStats *attrs[] = {&stats->distance, &stats->baseTime, &stats->cost, &stats->reliability, &stats->toll};
+        for (int i = 0; i < 5; i++)
+            attrs[i]->min = attrs[i]->max = 0.0f;
+    }
+    stats->density = V > 1 ? (csr->E * 100.0) / ((double)V * (V - 1)) : 0.0;
+    stats->diameterSamples = bfsSamples;
+    stats->diameter = sampledDiameter(csr, reverse, bfsSamples);
+    stats->seconds = chronometre() - t0;
+    return true;
+}
+
+static void printAttrStats(const char *name, const AttrStats *attr, int E)
+{
+    printf("%s: min %.2f, max %.2f, moyenne %.2f\n", name, attr->min, attr->max, E > 0 ? attr->sum / E : 0.0);
+}
+
+void printGraphStats(const GraphStats *stats)
+{
+    if (stats->V > 1)
+        printf("Densité: %.2f%%\n", stats->density);
+    else
+        printf("Densité: Non applicable (graphe avec moins de 2 sommets).\n");
+    printf("Degrés sortants: min %d, max %d, moyenne %.2f\n", stats->minOutDegree, stats->maxOutDegree,
+           stats->V > 0 ? (double)stats->E / stats->V : 0.0);
+    printf("Degrés entrants: min %d, max %d\n", stats->minInDegree, stats->maxInDegree);
+    printAttrStats("Distance (km)", &stats->distance, stats->E);
+    printAttrStats("Temps (min)", &stats->baseTime, stats->E);
+    printAttrStats("Coût", &stats->cost, stats->E);
+    printAttrStats("Fiabilité", &stats->reliability, stats->E);
+    printf("Types de route:");
+    bool shown = false;
+    for (int i = 0; i < STATS_ROAD_TYPES; i++)
+        if (stats->roadTypes[i] > 0)
+        {
+            // Dernier seau : types >= STATS_ROAD_TYPES - 1 et types négatifs
+            if (i == STATS_ROAD_TYPES - 1)
+                printf("%s autres: %d", shown ? "," : "", stats->roadTypes[i]);
+            else
+                printf("%s %d: %d", shown ? "," : "", i, stats->roadTypes[i]);
+            shown = true;
+        }
+    printf("\n");
+    printf("Péages: %d arêtes, %.0f au total\n", stats->tollEdges, stats->toll.sum);
+    if (stats->diameterSamples > 0)
+        printf("Diamètre estimé: %d arêtes (%d parcours)\n", stats->diameter, stats->diameterSamples);
+}
+
+// Ancienne interface sur les listes chaînées : statistiques du CSR équivalent
+void calculateConnectivityStats(Graph *graph)
+{
+    CSRGraph *csr = buildCSR(graph);
+    GraphStats stats;
+    if (csr && calculateConnectivityStatsCSR(csr, NULL, STATS_BFS_SAMPLES, &stats))
+        printGraphStats(&stats);
+    freeCSR(csr);
+}
+
+static cJSON *attrStatsToJSON(cJSON *parent, const char *name, const AttrStats *attr, int E)
+{
+    cJSON *object = cJSON_AddObjectToObject(parent, name);
+    if (object)
+    {
+        cJSON_AddNumberToObject(object, "min", attr->min);
+        cJSON_AddNumberToObject(object, "max", attr->max);
+        cJSON_AddNumberToObject(object, "mean", E > 0 ? attr->sum / E : 0.0);
+    }
+    return object;
+}
+
+static void degreeStatsToJSON(cJSON *parent, const char *name, int min, int max, const int *histogram, int V, int E)
+{
+    cJSON *object = cJSON_AddObjectToObject(parent, name);
+    if (!object)
+        return;
+    cJSON_AddNumberToObject(object, "min", min);
+    cJSON_AddNumberToObject(object, "max", max);
+    cJSON_AddNumberToObject(object, "mean", V > 0 ? (double)E / V : 0.0);
+    cJSON_AddItemToObject(object, "histogram", cJSON_CreateIntArray(histogram, STATS_DEGREE_BUCKETS));
+}
+
+// Statistiques au format JSON (clés alignées sur celles de graph.json), à libérer par
+// cJSON_Delete. Le dernier seau des histogrammes et des types de route regroupe le reste.
+cJSON *graphStatsToJSON(const GraphStats *stats)
+{
+    cJSON *root = cJSON_CreateObject();
+    if (!root)
+        return NULL;
+    cJSON_AddNumberToObject(root, "vertices", stats->V);
+    cJSON_AddNumberToObject(root, "edges", stats->E);
+    cJSON_AddNumberToObject(root, "density", stats->density);
+    degreeStatsToJSON(root, "outDegree", stats->minOutDegree, stats->maxOutDegree, stats->outDegreeHistogram, stats->V,
+                      stats->E);
+    degreeStatsToJSON(root, "inDegree", stats->minInDegree, stats->maxInDegree, stats->inDegreeHistogram, stats->V,
+                      stats->E);
+    attrStatsToJSON(root, "distance", &stats->distance, stats->E);
+    attrStatsToJSON(root, "baseTime", &stats->baseTime, stats->E);
+    attrStatsToJSON(root, "cost", &stats->cost, stats->E);
+    attrStatsToJSON(root, "reliability", &stats->reliability, stats->E);
+    cJSON *toll = attrStatsToJSON(root, "toll", &stats->toll, stats->E);
+    if (toll)
+    {
+        cJSON_AddNumberToObject(toll, "edges", stats->tollEdges);
+        cJSON_AddNumberToObject(toll, "total", stats->toll.sum);
+    }
+    cJSON_AddItemToObject(root, "roadTypes", cJSON_CreateIntArray(stats->roadTypes, STATS_ROAD_TYPES));
+    cJSON_AddNumberToObject(root, "restrictedEdges", stats->restrictedEdges);
+    cJSON *diameter = cJSON_AddObjectToObject(root, "diameter");
+    if (diameter)
+    {
+        cJSON_AddNumberToObject(diameter, "lowerBound", stats->diameter);
+        cJSON_AddNumberToObject(diameter, "samples", stats->diameterSamples);
+    }
+    cJSON_AddNumberToObject(root, "seconds", stats->seconds);
+    return root;
+}
+
+// Mode --stats : statistiques de graph.json (ou de son instantané s'il est à jour) en JSON.
+// La sortie standard ne porte que le document : le chargement et le calcul écrivent leurs
+// messages (instantané ignoré, erreurs) sur stderr.
+int exportGraphStats(const char *jsonFile, const char *snapshotFile)
+{
+    CSRGraph *csr = openCSRSnapshot(snapshotFile, jsonFile, true);
+    if (!csr)
+    {
+        Graph *graph = loadGraphFromJSONStream(jsonFile);
+        if (!graph)
+        {
+            fprintf(stderr, "Erreur lors du chargement du graphe.\n");
+            return 1;
+        }
+        csr = buildCSR(graph);
+        freeGraph(graph);
+        if (!csr)
+            return 1;
+    }
+
+    ReverseCSR *reverse = buildReverseCSR(csr);
+    GraphStats stats;
+    cJSON *json = NULL;
+    char *text = NULL;
+    if (calculateConnectivityStatsCSR(csr, reverse, STATS_BFS_SAMPLES, &stats))
+        json = graphStatsToJSON(&stats);
+    if (json)
+        text = cJSON_Print(json);
+    if (text)
+        printf("%s\n", text);
+
+    free(text);
+    cJSON_Delete(json);
+    freeReverseCSR(reverse);
+    freeCSR(csr);
+    return text ? 0 : 1;
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> FONCTION PRINCIPALE
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+int main(int argc, char *argv[])
+{
+    // Mode benchmark : main --bench <nom> [paramètres]
+    if (argc >= 2 && strcmp(argv[1], "--bench") == 0)
+        return lancerBenchmark(argc - 2, argv + 2);
+
+    // Mode conversion : main --convert [graph.json] [graph.bin]
+    if (argc >= 2 && strcmp(argv[1], "--convert") == 0)
+        return convertGraphToSnapshot(argc >= 3 ? argv[2] : "graph.json", argc >= 4 ? argv[3] : "graph.bin");
+
+    // Mode statistiques (JSON sur la sortie standard) : main --stats [graph.json] [graph.bin]
+    if (argc >= 2 && strcmp(argv[1], "--stats") == 0)
+        return exportGraphStats(argc >= 3 ? argv[2] : "graph.json", argc >= 4 ? argv[3] : "graph.bin");
+
+    // Démarrage direct depuis l'instantané binaire s'il est à jour, sinon depuis graph.json
+    CSRGraph *csr = openCSRSnapshot("graph.bin", "graph.json", true);
+    if (!csr)
+    {
+        Graph *graph = loadGraphFromJSONStream("graph.json");
+        if (!graph)
+        {
+            printf("Erreur lors du chargement du graphe.\n");
+            return 1;
+        }
+
+        // printGraph(graph);
+
+        // Représentation compacte utilisée par tous les algorithmes
+        csr = buildCSR(graph);
+        freeGraph(graph);
+        if (!csr)
+        {
+            printf("Erreur lors de la construction du graphe CSR.\n");
+            return 1;
+        }
+    }
+
+    // Appel de DFS à partir du sommet 0 (par exemple, Abidjan)
+    dfsCSR(csr, 0);
+
+    // Appel de BFS à partir du sommet 0 (par exemple, Abidjan)
+    bfsCSR(csr, 0);
+
+    // Détecter les cycles dans le réseaus
+    printf("\n=== Analyse du réseau ===\n");
+    printf("Cycles détectés: %s\n", detectCyclesCSR(csr, CYCLE_DIRECTED) ? "OUI" : "NON");
+    CycleReport *cycles = findCyclesCSR(csr);
+    if (cycles && cycles->components > 0)
+        printCycleReport(csr, cycles);
+    freeCycleReport(cycles);
+    printf("\nComposantes connexes:\n");
+    findConnectedComponentsCSR(csr);
+    ReachabilityIndex *reach = buildReachabilityIndex(csr);
+    if (reach)
+        printf("\nComposantes fortement connexes: %d\n", reach->C);
+    printf("\nAccessibilité Abidjan -> San-Pédro: %s\n",
+           (reach ? isAccessibleIndexed(reach, 0, 3) : isAccessibleCSR(csr, 0, 3)) ? "OUI" : "NON");
+    freeReachabilityIndex(reach);
+    printf("\nStatistiques:\n");
+    GraphStats stats;
+    if (calculateConnectivityStatsCSR(csr, NULL, STATS_BFS_SAMPLES, &stats))
+        printGraphStats(&stats);
+
+    // >>>>>>>>> Floyd-Warshall <<<<<<<<<<<
+    DistMatrix *distFW = createDistMatrix(csr->V);
+    if (distFW)
+    {
+        floydWarshallCSR(csr, distFW);
+        printFloydWarshallCSR(csr, distFW);
+        freeDistMatrix(distFW);
+    }
+
+    // >>>>>>>>>> Chemins optimaux sous contrainte de temps <<<<<<<<<<<
+    int src = 0;         // Abidjan
+    float maxTime = 300; // En minutes, par exemple
+
+    // Étiquettes de Pareto (exact) si les poids sont positifs, sinon Bellman-Ford (SPFA)
+    RCSPLabels *labels = hasNegativeWeights(csr) ? NULL : createRCSPLabels(csr->V);
+    if (labels && rcspCSR(csr, src, -1, maxTime, labels))
+    {
+        printResourceConstrainedPathsCSR(csr, src, labels);
+    }
+    else
+    {
+        float *distBF = malloc(csr->V * sizeof(float));
+        int *pred = malloc(csr->V * sizeof(int));
+        if (distBF && pred)
+        {
+            ShortestPathMode mode = shortestPathsCSR(csr, src, distBF, pred, maxTime, SP_AUTO);
+            printShortestPathsCSR(csr, src, distBF, pred, shortestPathModeName(mode));
+        }
+        else
+        {
+            printf("Erreur : allocation mémoire échouée pour les plus courts chemins.\n");
+        }
+        free(distBF);
+        free(pred);
+    }
+    freeRCSPLabels(labels);
+
+    // >>>>>>>>>> Hiérarchie de contraction <<<<<<<<<<<
+    // Prétraitée une fois puis rechargée depuis graph.ch tant que le graphe ne change pas
+    int dest = 3; // San-Pédro
+    CHGraph *ch = openContractionHierarchy(csr, METRIC_TIME, "graph.ch");
+    CHQuery *query = ch ? createCHQuery(csr->V) : NULL;
+    int *path = malloc(csr->V * sizeof(int));
+    if (query && path)
+    {
+        int length;
+        float duree = chQuery(ch, query, src, dest, path, &length);
+        printf("\n===== Itinéraire le plus rapide %s -> %s (HIÉRARCHIE DE CONTRACTION) =====\n",
+               csrCityName(csr, src), csrCityName(csr, dest));
+        if (duree == INF)
+        {
+            printf("Aucun chemin.\n");
+        }
+        else
+        {
+            printf("Temps = %.2f, Chemin = ", duree);
+            for (int j = 0; j < length; j++)
+                printf("%s%s", csrCityName(csr, path[j]), j < length - 1 ? " -> " : "\n");
+        }
+    }
+    free(path);
+    freeCHQuery(query);
+    freeContractionHierarchy(ch);
+
+    // >>>>>>>>>> GLOUTONNE <<<<<<<<<<<
+    LotColis colis;
+    Flotte flotte;
+    Carte carte;
+    initialiserLotColis(&colis);
+    initialiserFlotte(&flotte);
+
+    // Distances réelles sur le réseau (km), calculées à la demande depuis les villes des véhicules
+    if (chargerColis(&colis) && chargerVehicules(&flotte) && initialiserCarte(&carte, csr, METRIC_DISTANCE))
+    {
+        affecterColis(&flotte, &colis, AFFECTATION_PROCHE, &carte, csr);
+        afficherTournees(&flotte, csr);
+        libererCarte(&carte);
+    }
+    libererLotColis(&colis);
+    libererFlotte(&flotte);
+
+    freeCSR(csr);
+    return 0;
+}
+
+// Fonction pour créer un graphe
+Graph *createGraph(int V)
+{
+    Graph *graph = (Graph *)malloc(sizeof(Graph));
+    if (!graph)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour le graphe.\n");
+        return NULL;
+    }
+
+    graph->V = V;
+    graph->array = (AdjList *)malloc(V * sizeof(AdjList));
+    graph->cityNames = (char **)malloc(V * sizeof(char *));
+    if (!graph->array || !graph->cityNames)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour les structures internes.\n");
+        free(graph->array);
+        free(graph->cityNames);
+        free(graph);
+        return NULL;
+    }
+
+    for (int i = 0; i < V; i++)
+    {
+        graph->array[i].head = NULL;
+        graph->cityNames[i] = NULL; // Initialiser à NULL
+    }
+
+    return graph;
+}
+
+// Fonction pour ajouter une arête au graphe
+void addEdge(Graph *graph, int src, int dest, EdgeAttr attr)
+{
+    if (src < 0 || src >= graph->V || dest < 0 || dest >= graph->V)
+    {
+        fprintf(stderr, "Erreur : arête invalide (%d -> %d).\n", src, dest);
+        return;
+    }
+
+    AdjListNode *newNode = (AdjListNode *)malloc(sizeof(AdjListNode));
+    if (!newNode)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour un nœud d'adjacence.\n");
+        return;
+    }
+
+    newNode->dest = dest;
+    newNode->attr = attr;
+    newNode->next = graph->array[src].head;
+    graph->array[src].head = newNode;
+}
+
+// Fonction pour afficher le graphe
+void printGraph(Graph *graph)
+{
+    printf("--------------------------------------------------------\n");
+    printf("|\t\t\tGRAPHE DES VILLES\t\t\t|\n");
+    printf("--------------------------------------------------------\n\n");
+
+    for (int i = 0; i < graph->V; i++)
+    {
+        printf("Ville de depart : %s\n", graph->cityNames[i] ? graph->cityNames[i] : "Inconnue");
+        AdjListNode *pCrawl = graph->array[i].head;
+
+        if (pCrawl == NULL)
+        {
+            printf("   Aucune destination disponible depuis cette ville.\n");
+        }
+        else
+        {
+            printf("   Destinations:\n");
+            while (pCrawl)
+            {
+                printf("   -> %s (Distance: %.2f km, Cost: %.2f XOF)\n",
+                       graph->cityNames[pCrawl->dest] ? graph->cityNames[pCrawl->dest] : "Inconnue",
+                       pCrawl->attr.distance, pCrawl->attr.cost);
+                pCrawl = pCrawl->next;
+            }
+        }
+        printf("\n");
+    }
+    printf("--------------------------------------------------------\n");
+}
+
+// Fonction pour libérer la mémoire allouée au graphe
+void freeGraph(Graph *graph)
+{
+    for (int i = 0; i < graph->V; i++)
+    {
+        AdjListNode *pCrawl = graph->array[i].head;
+        while (pCrawl)
+        {
+            AdjListNode *temp = pCrawl;
+            pCrawl = pCrawl->next;
+            free(temp); // Libère chaque nœud
+        }
+        free(graph->cityNames[i]); // Libère chaque nom de ville
+    }
+    free(graph->cityNames);
+    free(graph->array); // Libère le tableau de listes
+    free(graph);        // Libère la structure du graphe
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> GRAPHE CSR
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Fonction pour construire la représentation CSR à partir des listes d'adjacence.
+// Le graphe chaîné reste la structure de construction (addEdge) ; le CSR est figé
+// une fois le chargement terminé et c'est lui que parcourent les algorithmes.
+// L'ordre des voisins de chaque sommet est celui des listes (tête en premier),
+// de sorte que les parcours donnent exactement les mêmes résultats.
+CSRGraph *buildCSR(Graph *graph)
+{
+    CSRGraph *csr = (CSRGraph *)calloc(1, sizeof(CSRGraph));
+    if (!csr)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour le graphe CSR.\n");
+        return NULL;
+    }
+
+    int V = graph->V;
+    csr->V = V;
+    csr->offsets = (int *)malloc((V + 1) * sizeof(int));
+    csr->nameOffsets = (int *)malloc((V + 1) * sizeof(int));
+    if (!csr->offsets || !csr->nameOffsets)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour les offsets CSR.\n");
+        freeCSR(csr);
+        return NULL;
+    }
+
+    // Premier passage : degrés sortants et taille de la table des noms
+    size_t namesSize = 0;
+    csr->offsets[0] = 0;
+    csr->nameOffsets[0] = 0;
+    for (int u = 0; u < V; u++)
+    {
+        int degree = 0;
+        for (AdjListNode *node = graph->array[u].head; node; node = node->next)
+            degree++;
+        csr->offsets[u + 1] = csr->offsets[u] + degree;
+
+        const char *name = graph->cityNames[u] ? graph->cityNames[u] : "Inconnue";
+        namesSize += strlen(name) + 1;
+        csr->nameOffsets[u + 1] = (int)namesSize;
+    }
+
+    int E = csr->offsets[V];
+    csr->E = E;
+    csr->dest = (int *)malloc(E * sizeof(int));
+    csr->distance = (float *)malloc(E * sizeof(float));
+    csr->baseTime = (float *)malloc(E * sizeof(float));
+    csr->cost = (float *)malloc(E * sizeof(float));
+    csr->roadType = (int *)malloc(E * sizeof(int));
+    csr->reliability = (float *)malloc(E * sizeof(float));
+    csr->restrictions = (int *)malloc(E * sizeof(int));
+    csr->toll = (int *)malloc(E * sizeof(int));
+    csr->names = (char *)malloc(namesSize);
+    if ((E > 0 && (!csr->dest || !csr->distance || !csr->baseTime || !csr->cost ||
+                   !csr->roadType || !csr->reliability || !csr->restrictions || !csr->toll)) ||
+        !csr->names)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour les aretes CSR.\n");
+        freeCSR(csr);
+        return NULL;
+    }
+
+    // Second passage : recopie des aretes dans les colonnes contiguës
+    for (int u = 0; u < V; u++)
+    {
+        int e = csr->offsets[u];
+        for (AdjListNode *node = graph->array[u].head; node; node = node->next, e++)
+        {
+            csr->dest[e] = node->dest;
+            csr->distance[e] = node->attr.distance;
+            csr->baseTime[e] = node->attr.baseTime;
+            csr->cost[e] = node->attr.cost;
+            csr->roadType[e] = node->attr.roadType;
+            csr->reliability[e] = node->attr.reliability;
+            csr->restrictions[e] = node->attr.restrictions;
+            csr->toll[e] = node->attr.toll;
+        }
+
+        const char *name = graph->cityNames[u] ? graph->cityNames[u] : "Inconnue";
+        memcpy(csr->names + csr->nameOffsets[u], name, csr->nameOffsets[u + 1] - csr->nameOffsets[u]);
+    }
+
+    return csr;
+}
+
+// Fonction pour obtenir le nom d'une ville dans le graphe CSR
+const char *csrCityName(const CSRGraph *csr, int v)
+{
+    return csr->names + csr->nameOffsets[v];
+}
+
+// Fonction pour libérer la mémoire allouée au graphe CSR
+void freeCSR(CSRGraph *csr)
+{
+    if (!csr)
+        return;
+    if (csr->mapping)
+    {
+        // Les tableaux pointent dans le fichier projeté : un seul démappage suffit
+        unmapFile(csr->mapping, csr->mappingSize);
+        free(csr);
+        return;
+    }
+    free(csr->offsets);
+    free(csr->dest);
+    free(csr->distance);
+    free(csr->baseTime);
+    free(csr->cost);
+    free(csr->roadType);
+    free(csr->reliability);
+    free(csr->restrictions);
+    free(csr->toll);
+    free(csr->nameOffsets);
+    free(csr->names);
+    free(csr);
+}
+
+// Fonction pour construire l'index inverse (arcs entrants) d'un graphe CSR, par tri
+// par dénombrement des arcs selon leur destination
+ReverseCSR *buildReverseCSR(const CSRGraph *csr)
+{
+    ReverseCSR *reverse = (ReverseCSR *)calloc(1, sizeof(ReverseCSR));
+    if (!reverse)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour l'index inverse.\n");
+        return NULL;
+    }
+    int V = csr->V, E = csr->E;
+    reverse->V = V;
+    reverse->E = E;
+    reverse->offsets = (int *)calloc(V + 1, sizeof(int));
+    reverse->source = (int *)malloc((E ? E : 1) * sizeof(int));
+    reverse->edge = (int *)malloc((E ? E : 1) * sizeof(int));
+    if (!reverse->offsets || !reverse->source || !reverse->edge)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour l'index inverse.\n");
+        freeReverseCSR(reverse);
+        return NULL;
+    }
+
+    for (int e = 0; e < E; e++)
+        reverse->offsets[csr->dest[e] + 1]++;
+    for (int v = 0; v < V; v++)
+        reverse->offsets[v + 1] += reverse->offsets[v];
+
+    // Remplissage : offsets[v] sert de curseur puis est restauré par décalage
+    for (int u = 0; u < V; u++)
+    {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+        {
+            int i = reverse->offsets[csr->dest[e]]++;
+            reverse->source[i] = u;
+            reverse->edge[i] = e;
+        }
+    }
+    for (int v = V; v > 0; v--)
+        reverse->offsets[v] = reverse->offsets[v - 1];
+    reverse->offsets[0] = 0;
+    return reverse;
+}
+
+void freeReverseCSR(ReverseCSR *reverse)
+{
+    if (!reverse)
+        return;
+    free(reverse->offsets);
+    free(reverse->source);
+    free(reverse->edge);
+    free(reverse);
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> INSTANTANÉ BINAIRE
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Fonction pour projeter un fichier en mémoire en lecture seule
+void *mapFile(const char *filename, size_t *size)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return NULL;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+        return NULL;
+    void *addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); // la vue garde la projection active
+    if (!addr)
+        return NULL;
+    *size = (size_t)length.QuadPart;
+    return addr;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return NULL;
+    }
+    void *addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // la projection reste valide après fermeture
+    if (addr == MAP_FAILED)
+        return NULL;
+    *size = (size_t)st.st_size;
+    return addr;
+#endif
+}
+
+void unmapFile(void *addr, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(addr);
+#else
+    munmap(addr, size);
+#endif
+}
+
+// Somme de contrôle rapide (mot de 64 bits par itération, variante de FNV-1a)
+static uint64_t snapshotChecksum(uint64_t hash, const unsigned char *data, size_t size)
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0x100000001B3ULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+        hash = (hash ^ data[i]) * 0x100000001B3ULL;
+    return hash;
+}
+
+// Adresses et tailles des sections du CSR, dans l'ordre du fichier
+static void snapshotSections(CSRGraph *csr, size_t namesSize, void ***fields, size_t *sizes)
+{
+    size_t V1 = (size_t)csr->V + 1, E = (size_t)csr->E;
+    void **all[SNAPSHOT_SECTIONS] = {
+        (void **)&csr->offsets, (void **)&csr->nameOffsets, (void **)&csr->dest,
+        (void **)&csr->distance, (void **)&csr->baseTime, (void **)&csr->cost,
+        (void **)&csr->roadType, (void **)&csr->reliability, (void **)&csr->restrictions,
+        (void **)&csr->toll, (void **)&csr->names};
+    size_t bytes[SNAPSHOT_SECTIONS] = {
+        V1 * sizeof(int), V1 * sizeof(int), E * sizeof(int),
+        E * sizeof(float), E * sizeof(float), E * sizeof(float),
+        E * sizeof(int), E * sizeof(float), E * sizeof(int),
+        E * sizeof(int), namesSize};
+    for (int s = 0; s < SNAPSHOT_SECTIONS; s++)
+    {
+        fields[s] = all[s];
+        sizes[s] = bytes[s];
+    }
+}
+
+static size_t snapshotAlign(size_t offset)
+{
+    return (offset + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+}
+
+// Lit la taille et la date de modification du fichier source (false s'il n'existe pas)
+static bool snapshotSourceStamp(const char *sourceFile, uint64_t *size, int64_t *mtime)
+{
+    struct stat st;
+    if (!sourceFile || stat(sourceFile, &st) != 0)
+        return false;
+    *size = (uint64_t)st.st_size;
+    *mtime = (int64_t)st.st_mtime;
+    return true;
+}
+
+// Fonction pour écrire l'instantané binaire d'un graphe CSR.
+// sourceFile (optionnel) est le graph.json dont il est issu : sa taille et sa date
+// sont enregistrées pour rejeter l'instantané si le JSON est modifié ensuite.
+bool saveCSRSnapshot(const CSRGraph *csr, const char *filename, const char *sourceFile)
+{
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.endianTag = SNAPSHOT_ENDIAN_TAG;
+    header.V = (uint32_t)csr->V;
+    header.E = (uint32_t)csr->E;
+    header.namesSize = (uint64_t)csr->nameOffsets[csr->V];
+    snapshotSourceStamp(sourceFile, &header.sourceSize, &header.sourceMtime);
+
+    void **fields[SNAPSHOT_SECTIONS];
+    size_t sizes[SNAPSHOT_SECTIONS];
+    snapshotSections((CSRGraph *)csr, (size_t)header.namesSize, fields, sizes);
+
+    size_t offset = snapshotAlign(sizeof(SnapshotHeader));
+    uint64_t checksum = 0xCBF29CE484222325ULL;
+    for (int s = 0; s < SNAPSHOT_SECTIONS; s++)
+    {
+        header.sectionOffset[s] = offset;
+        checksum = snapshotChecksum(checksum, (const unsigned char *)*fields[s], sizes[s]);
+        offset = snapshotAlign(offset + sizes[s]);
+    }
+    header.checksum = checksum;
+    header.fileSize = offset;
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        printf("Erreur : impossible de créer le fichier %s\n", filename);
+        return false;
+    }
+
+    static const char padding[SNAPSHOT_ALIGN] = {0};
+    size_t written = fwrite(&header, sizeof(header), 1, file) == 1 ? sizeof(header) : 0;
+    bool ok = written > 0;
+    for (int s = 0; s < SNAPSHOT_SECTIONS && ok; s++)
+    {
+        ok = fwrite(padding, 1, header.sectionOffset[s] - written, file) == header.sectionOffset[s] - written &&
+             (sizes[s] == 0 || fwrite(*fields[s], 1, sizes[s], file) == sizes[s]);
+        written = header.sectionOffset[s] + sizes[s];
+    }
+    if (ok)
+        ok = fwrite(padding, 1, header.fileSize - written, file) == header.fileSize - written;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        printf("Erreur : écriture de l'instantané %s incomplète.\n", filename);
+        remove(filename);
+    }
+    return ok;
+}
+
+// Fonction pour ouvrir un instantané par projection mémoire, sans copie : les
+// tableaux du CSR pointent directement dans le fichier. Retourne NULL (en silence
+// si le fichier n'existe pas) lorsque l'instantané est absent, corrompu, d'une
+// autre version ou plus ancien que sourceFile.
+CSRGraph *openCSRSnapshot(const char *filename, const char *sourceFile, bool verifyChecksum)
+{
+    size_t size;
+    unsigned char *data = (unsigned char *)mapFile(filename, &size);
+    if (!data)
+        return NULL;
+
+    const char *error = NULL;
+    SnapshotHeader header;
+    if (size < sizeof(header))
+        error = "fichier tronqué";
+    else
+    {
+        memcpy(&header, data, sizeof(header));
+        uint64_t sourceSize;
+        int64_t sourceMtime;
+        if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0)
+            error = "format inconnu";
+        else if (header.version != SNAPSHOT_VERSION || header.endianTag != SNAPSHOT_ENDIAN_TAG)
+            error = "version ou boutisme incompatible";
+        else if (header.fileSize != size)
+            error = "taille incohérente";
+        else if (snapshotSourceStamp(sourceFile, &sourceSize, &sourceMtime) &&
+                 (sourceSize != header.sourceSize || sourceMtime != header.sourceMtime))
+            error = "instantané périmé (le fichier source a changé)";
+    }
+
+    CSRGraph *csr = NULL;
+    if (!error)
+    {
+        csr = (CSRGraph *)calloc(1, sizeof(CSRGraph));
+        if (!csr)
+            error = "allocation mémoire échouée";
+    }
+
+    if (!error)
+    {
+        csr->V = (int)header.V;
+        csr->E = (int)header.E;
+        void **fields[SNAPSHOT_SECTIONS];
+        size_t sizes[SNAPSHOT_SECTIONS];
+        snapshotSections(csr, (size_t)header.namesSize, fields, sizes);
+
+        uint64_t checksum = 0xCBF29CE484222325ULL;
+        for (int s = 0; s < SNAPSHOT_SECTIONS && !error; s++)
+        {
+            if (header.sectionOffset[s] % SNAPSHOT_ALIGN != 0 || header.sectionOffset[s] > size ||
+                sizes[s] > size - header.sectionOffset[s])
+                error = "section hors du fichier";
+            else
+            {
+                *fields[s] = data + header.sectionOffset[s];
+                if (verifyChecksum)
+                    checksum = snapshotChecksum(checksum, data + header.sectionOffset[s], sizes[s]);
+            }
+        }
+        if (!error && verifyChecksum && checksum != header.checksum)
+            error = "somme de contrôle invalide";
+        if (!error && (csr->offsets[0] != 0 || csr->offsets[csr->V] != csr->E ||
+                       (uint64_t)csr->nameOffsets[csr->V] != header.namesSize))
+            error = "offsets incohérents";
+    }
+
+    if (error)
+    {
+        fprintf(stderr, "Instantané %s ignoré : %s.\n", filename, error);
+        free(csr);
+        unmapFile(data, size);
+        return NULL;
+    }
+
+    csr->mapping = data;
+    csr->mappingSize = size;
+    return csr;
+}
+
+// Mode conversion : graph.json -> instantané binaire
+int convertGraphToSnapshot(const char *jsonFile, const char *snapshotFile)
+{
+    Graph *graph = loadGraphFromJSONStream(jsonFile);
+    if (!graph)
+        return 1;
+    CSRGraph *csr = buildCSR(graph);
+    freeGraph(graph);
+    if (!csr)
+        return 1;
+
+    bool ok = saveCSRSnapshot(csr, snapshotFile, jsonFile);
+    if (ok)
+        printf("Instantané %s écrit : %d sommets, %d arêtes.\n", snapshotFile, csr->V, csr->E);
+    freeCSR(csr);
+    return ok ? 0 : 1;
+}
+
+/**
+ * - **Pile explicite (DFS)** :
+ *   L'algorithme DFS utilise une pile explicite (`DFSEngine`) : chaque niveau garde le sommet
+ *   courant et l'indice du prochain arc à examiner, ce qui reproduit exactement l'ordre de la
+ *   version récursive sans consommer la pile d'exécution. Une longue chaîne de tronçons
+ *   (des centaines de milliers de sommets) ne provoque donc plus de dépassement de pile.
+ *   Les sommets visités sont tenus dans un ensemble de bits. Le même moteur, paramétré par
+ *   des rappels (pré-ordre, post-ordre, arcs hors arbre), sert au parcours, à la détection
+ *   de cycles, au tri topologique et aux composantes fortement connexes.
+ *
+ * - **File explicite (BFS)** :
+ *   L'algorithme BFS utilise une file explicite implémentée à l'aide d'un tableau dynamique
+ *   (int *queue) et de deux indices (`front` et `rear`) pour gérer les opérations d'enfilement
+ *   et de défilement. Ce choix est justifié par la nécessité de traiter les sommets dans l'ordre
+ *   dans lequel ils sont découverts, ce qui est une caractéristique clé du BFS. L'utilisation
+ *   d'un tableau dynamique permet une gestion simple et efficace de la file.
+ *   Pour les grands réseaux, `bfsDirectionOptimizing` tient visités et frontière dans des
+ *   ensembles de bits (mots de 64 sommets) et alterne entre cette file (étapes descendantes)
+ *   et un balayage des sommets non visités par leurs arcs entrants (étapes montantes) quand
+ *   la frontière devient grande ; niveaux et parents sont rendus dans des tableaux.
+ *
+ * @note Les structures auxiliaires (pile et file explicites) sont adaptées aux besoins
+ * spécifiques des algorithmes DFS et BFS respectivement, garantissant une implémentation efficace
+ * et conforme aux principes de ces parcours.
+ */
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> DFS ALGORITHM
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DFSEngine *createDFSEngine(int V)
+{
+    DFSEngine *engine = (DFSEngine *)calloc(1, sizeof(DFSEngine));
+    int words = (V + 63) / 64;
+    if (engine)
+    {
+        engine->V = V;
+        engine->visited = (uint64_t *)calloc(words > 0 ? words : 1, sizeof(uint64_t));
+        engine->onPath = (uint64_t *)calloc(words > 0 ? words : 1, sizeof(uint64_t));
+        engine->stack = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+        engine->edgeIter = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    }
+    if (!engine || !engine->visited || !engine->onPath || !engine->stack || !engine->edgeIter)
+    {
+        printf("Erreur : allocation mémoire échouée pour le parcours en profondeur.\n");
+        freeDFSEngine(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+void freeDFSEngine(DFSEngine *engine)
+{
+    if (!engine)
+        return;
+    free(engine->visited);
+    free(engine->onPath);
+    free(engine->stack);
+    free(engine->edgeIter);
+    free(engine);
+}
+
+// Oublie les sommets découverts (V / 64 mots remis à zéro)
+void dfsEngineReset(DFSEngine *engine)
+{
+    memset(engine->visited, 0, ((engine->V + 63) / 64) * sizeof(uint64_t));
+    engine->maxDepth = 0;
+}
+
+bool dfsEngineVisited(const DFSEngine *engine, int v)
+{
+    return (engine->visited[v >> 6] >> (v & 63)) & 1;
+}
+
+// Parcours en profondeur depuis root des sommets non encore découverts. Les arcs de chaque
+// sommet sont examinés dans l'ordre du CSR, comme le faisait la version récursive.
+// Retourne false si un rappel a interrompu le parcours (le moteur reste alors utilisable).
+bool dfsEngineRun(DFSEngine *engine, const CSRGraph *csr, int root, const DFSVisitor *visitor)
+{
+    if (dfsEngineVisited(engine, root))
+        return true;
+
+    uint64_t *visited = engine->visited, *onPath = engine->onPath;
+    int *stack = engine->stack, *edgeIter = engine->edgeIter;
+    void *context = visitor->context;
+    int depth = 0;
+    bool ok = true;
+
+    visited[root >> 6] |= 1ULL << (root & 63);
+    onPath[root >> 6] |= 1ULL << (root & 63);
+    stack[0] = root;
+    edgeIter[0] = csr->offsets[root];
+    depth = 1;
+    if (depth > engine->maxDepth)
+        engine->maxDepth = depth;
+    if (visitor->preVisit)
+        ok = visitor->preVisit(context, root, -1);
+
+    while (ok && depth > 0)
+    {
+        int u = stack[depth - 1];
+        int parent = depth > 1 ? stack[depth - 2] : -1;
+        if (edgeIter[depth - 1] < csr->offsets[u + 1])
+        {
+            int v = csr->dest[edgeIter[depth - 1]++];
+            uint64_t bit = 1ULL << (v & 63);
+            if (!(visited[v >> 6] & bit))
+            {
+                visited[v >> 6] |= bit;
+                onPath[v >> 6] |= bit;
+                stack[depth] = v;
+                edgeIter[depth] = csr->offsets[v];
+                depth++;
+                if (depth > engine->maxDepth)
+                    engine->maxDepth = depth;
+                if (visitor->preVisit)
+                    ok = visitor->preVisit(context, v, u);
+            }
+            else if (visitor->nonTreeEdge)
+            {
+                DFSEdgeKind kind = (onPath[v >> 6] & bit) ? DFS_BACK_EDGE : DFS_FORWARD_CROSS_EDGE;
+                ok = visitor->nonTreeEdge(context, u, v, parent, kind);
+            }
+            continue;
+        }
+
+        depth--;
+        onPath[u >> 6] &= ~(1ULL << (u & 63));
+        if (visitor->postVisit)
+            ok = visitor->postVisit(context, u, parent);
+    }
+
+    // Parcours interrompu : le chemin restant quitte l'ensemble des sommets gris
+    while (depth > 0)
+    {
+        int u = stack[--depth];
+        onPath[u >> 6] &= ~(1ULL << (u & 63));
+    }
+    return ok;
+}
+
+// Fonction principale pour effectuer un DFS sur tout le graphe
+void dfs(Graph *graph, int startVertex)
+{
+    CSRGraph *csr = buildCSR(graph);
+    if (!csr)
+        return;
+    dfsCSR(csr, startVertex);
+    freeCSR(csr);
+}
+
+static bool dfsPrintVisit(void *context, int v, int parent)
+{
+    (void)parent;
+    printf("%s ", csrCityName((const CSRGraph *)context, v));
+    return true;
+}
+
+void dfsCSR(const CSRGraph *csr, int startVertex)
+{
+    DFSEngine *engine = createDFSEngine(csr->V);
+    if (!engine)
+        return;
+
+    printf("Parcours en profondeur (DFS) à partir de %s :\n", csrCityName(csr, startVertex));
+    DFSVisitor visitor = {dfsPrintVisit, NULL, NULL, (void *)csr};
+    dfsEngineRun(engine, csr, startVertex, &visitor);
+
+    printf("\n");
+
+    freeDFSEngine(engine);
+}
+
+static bool topologicalPostVisit(void *context, int v, int parent)
+{
+    TopologicalState *state = (TopologicalState *)context;
+    (void)parent;
+    state->order[--state->next] = v;
+    return true;
+}
+
+static bool topologicalNonTreeEdge(void *context, int u, int v, int parent, DFSEdgeKind kind)
+{
+    (void)context;
+    (void)u;
+    (void)v;
+    (void)parent;
+    return kind != DFS_BACK_EDGE; // un arc arrière ferme un circuit : pas d'ordre topologique
+}
+
+// Range les sommets dans order de sorte que tout arc u -> v place u avant v.
+// Retourne false si le graphe contient un circuit (order est alors incomplet).
+bool topologicalOrderCSR(const CSRGraph *csr, int *order)
+{
+    DFSEngine *engine = createDFSEngine(csr->V);
+    if (!engine)
+        return false;
+
+    TopologicalState state = {order, csr->V};
+    DFSVisitor visitor = {NULL, topologicalPostVisit, topologicalNonTreeEdge, &state};
+    bool acyclic = true;
+    for (int v = 0; v < csr->V && acyclic; v++)
+        acyclic = dfsEngineRun(engine, csr, v, &visitor);
+
+    freeDFSEngine(engine);
+    return acyclic;
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> BFS ALGORITHM
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Fonction pour effectuer un parcours en largeur (BFS) à partir d'un sommet donné
+void bfs(Graph *graph, int startVertex)
+{
+    // Créer un tableau pour suivre les sommets visités
+    bool *visited = (bool *)malloc(graph->V * sizeof(bool));
+    for (int i = 0; i < graph->V; i++)
+        visited[i] = false;
+
+    // Créer une file pour le BFS
+    int *queue = (int *)malloc(graph->V * sizeof(int));
+    int front = 0, rear = 0;
+
+    // Marquer le sommet de départ comme visité et l'ajouter à la file
+    visited[startVertex] = true;
+    queue[rear++] = startVertex;
+
+    printf("Parcours en largeur (BFS) à partir de %s :\n", graph->cityNames[startVertex]);
+
+    while (front < rear)
+    {
+        // Extraire un sommet de la file
+        int currentVertex = queue[front++];
+        printf("%s ", graph->cityNames[currentVertex]);
+
+        // Parcourir tous les voisins du sommet actuel
+        AdjListNode *node = graph->array[currentVertex].head;
+        while (node)
+        {
+            if (!visited[node->dest])
+            {
+                visited[node->dest] = true;
+                queue[rear++] = node->dest;
+            }
+            node = node->next;
+        }
+    }
+
+    printf("\n");
+
+    // Libérer la mémoire
+    free(visited);
+    free(queue);
+}
+
+void bfsCSR(const CSRGraph *csr, int startVertex)
+{
+    bool *visited = (bool *)calloc(csr->V, sizeof(bool));
+    int *queue = (int *)malloc(csr->V * sizeof(int));
+    if (!visited || !queue)
+    {
+        printf("Erreur : allocation mémoire échouée pour le parcours en largeur.\n");
+        free(visited);
+        free(queue);
+        return;
+    }
+    int front = 0, rear = 0;
+
+    visited[startVertex] = true;
+    queue[rear++] = startVertex;
+
+    printf("Parcours en largeur (BFS) à partir de %s :\n", csrCityName(csr, startVertex));
+
+    while (front < rear)
+    {
+        int currentVertex = queue[front++];
+        printf("%s ", csrCityName(csr, currentVertex));
+
+        for (int e = csr->offsets[currentVertex]; e < csr->offsets[currentVertex + 1]; e++)
+        {
+            int v = csr->dest[e];
+            if (!visited[v])
+            {
+                visited[v] = true;
+                queue[rear++] = v;
+            }
+        }
+    }
+
+    printf("\n");
+
+    free(visited);
+    free(queue);
+}
+
+// Indice du bit de poids faible d'un mot non nul (ensembles de bits des parcours)
+static inline int bitsetLowest(uint64_t bits)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    int i = 0;
+    while (!(bits & 1))
+    {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+BFSTree *createBFSTree(int V)
+{
+    BFSTree *tree = (BFSTree *)calloc(1, sizeof(BFSTree));
+    int words = (V + 63) / 64 > 0 ? (V + 63) / 64 : 1;
+    if (tree)
+    {
+        tree->V = V;
+        tree->level = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+        tree->parent = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+        tree->queue = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+        tree->visited = (uint64_t *)calloc(words, sizeof(uint64_t));
+        tree->frontier = (uint64_t *)calloc(words, sizeof(uint64_t));
+        tree->next = (uint64_t *)calloc(words, sizeof(uint64_t));
+    }
+    if (!tree || !tree->level || !tree->parent || !tree->queue || !tree->visited || !tree->frontier || !tree->next)
+    {
+        fprintf(stderr, "Erreur : allocation mémoire échouée pour le parcours en largeur.\n");
+        freeBFSTree(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+void freeBFSTree(BFSTree *tree)
+{
+    if (!tree)
+        return;
+    free(tree->level);
+    free(tree->parent);
+    free(tree->queue);
+    free(tree->visited);
+    free(tree->frontier);
+    free(tree->next);
+    free(tree);
+}
+
+// Étape montante : chaque sommet non visité cherche un parent dans la frontière parmi ses
+// arcs entrants et s'arrête au premier trouvé. Les mots de 64 sommets sont indépendants
+// (un sommet n'écrit que dans son propre mot), ils sont répartis entre les threads.
+// Retourne le nombre de sommets atteints ; *inEdges reçoit la somme de leurs degrés entrants.
+static int bfsBottomUpStep(const ReverseCSR *reverse, BFSTree *tree, int level, long long *inEdges)
+{
+    int V = tree->V, words = (V + 63) / 64;
+    const uint64_t *frontier = tree->frontier;
+    uint64_t *visited = tree->visited, *next = tree->next;
+    int found = 0;
+    long long degrees = 0;
+
+    OMP_PRAGMA(omp parallel for schedule(dynamic, 256) reduction(+ : found, degrees))
+    for (int w = 0; w < words; w++)
+    {
+        uint64_t todo = ~visited[w];
+        if (w == words - 1 && (V & 63))
+            todo &= (1ULL << (V & 63)) - 1;
+        uint64_t added = 0;
+        while (todo)
+        {
+            int v = w * 64 + bitsetLowest(todo);
+            todo &= todo - 1;
+            for (int r = reverse->offsets[v]; r < reverse->offsets[v + 1]; r++)
+            {
+                int u = reverse->source[r];
+                if ((frontier[u >> 6] >> (u & 63)) & 1)
+                {
+                    tree->parent[v] = u;
+                    tree->level[v] = level + 1;
+                    added |= 1ULL << (v & 63);
+                    found++;
+                    degrees += reverse->offsets[v + 1] - reverse->offsets[v];
+                    break;
+                }
+            }
+        }
+        next[w] = added;
+        visited[w] |= added;
+    }
+
+    *inEdges = degrees;
+    return found;
+}
+
+// Parcours en largeur depuis src, en alternant étapes descendantes (file) et montantes
+// (ensembles de bits) selon la taille de la frontière (heuristique de Beamer et al.).
+// reverse peut être NULL : le parcours reste alors entièrement descendant.
+// Remplit tree->level et tree->parent ; retourne le nombre de sommets atteints.
+int bfsDirectionOptimizing(const CSRGraph *csr, const ReverseCSR *reverse, BFSTree *tree, int src)
+{
+    int V = csr->V, words = (V + 63) / 64;
+    int *levels = tree->level, *parents = tree->parent, *queue = tree->queue;
+    uint64_t *visited = tree->visited;
+    for (int v = 0; v < V; v++)
+        levels[v] = parents[v] = -1;
+    memset(visited, 0, (words > 0 ? words : 1) * sizeof(uint64_t));
+    tree->topDownSteps = tree->bottomUpSteps = 0;
+
+    levels[src] = 0;
+    visited[src >> 6] |= 1ULL << (src & 63);
+    queue[0] = src;
+    int head = 0, tail = 1; // frontière descendante : queue[head .. tail - 1]
+    int frontierSize = 1, previousSize = 0, reached = 1, level = 0;
+    bool bottomUp = false;
+
+    // Arcs encore à explorer, estimés en retirant les arcs de chaque sommet atteint (degré
+    // sortant en descendant, déjà en cache ; degré entrant en montant)
+    long long unexplored = csr->E - (csr->offsets[src + 1] - csr->offsets[src]);
+
+    while (frontierSize > 0)
+    {
+        if (reverse && !bottomUp && frontierSize > previousSize)
+        {
+            long long frontierEdges = 0;
+            for (int i = head; i < tail; i++)
+                frontierEdges += csr->offsets[queue[i] + 1] - csr->offsets[queue[i]];
+            if (frontierEdges > unexplored / BFS_ALPHA)
+            {
+                // Passage au montant : la file devient un ensemble de bits
+                memset(tree->frontier, 0, words * sizeof(uint64_t));
+                for (int i = head; i < tail; i++)
+                    tree->frontier[queue[i] >> 6] |= 1ULL << (queue[i] & 63);
+                bottomUp = true;
+            }
+        }
+        else if (bottomUp && frontierSize < previousSize && frontierSize < V / BFS_BETA)
+        {
+            // Retour au descendant : l'ensemble de bits redevient une file
+            head = tail = 0;
+            for (int w = 0; w < words; w++)
+                for (uint64_t bits = tree->frontier[w]; bits; bits &= bits - 1)
+                    queue[tail++] = w * 64 + bitsetLowest(bits);
+            bottomUp = false;
+        }
+        previousSize = frontierSize;
+
+        if (bottomUp)
+        {
+            long long inEdges = 0;
+            frontierSize = bfsBottomUpStep(reverse, tree, level, &inEdges);
+            unexplored -= inEdges;
+            uint64_t *swap = tree->frontier;
+            tree->frontier = tree->next;
+            tree->next = swap;
+            tree->bottomUpSteps++;
+        }
+        else
+        {
+            int end = tail;
+            for (int i = head; i < end; i++)
+            {
+                int u = queue[i];
+                for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+                {
+                    int v = csr->dest[e];
+                    uint64_t bit = 1ULL << (v & 63);
+                    if (visited[v >> 6] & bit)
+                        continue;
+                    visited[v >> 6] |= bit;
+                    levels[v] = level + 1;
+                    parents[v] = u;
+                    queue[tail++] = v;
+                    unexplored -= csr->offsets[v + 1] - csr->offsets[v];
+                }
+            }
+            head = end;
+            frontierSize = tail - head;
+            tree->topDownSteps++;
+        }
+        reached += frontierSize;
+        if (frontierSize > 0)
+            level++;
+    }
+
+    tree->reached = reached;
+    tree->depth = level;
+    return reached;
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> FLOYD-WARSHALL ALGORITHM
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Fonction pour allouer une matrice de distances n x n alignée
+DistMatrix *createDistMatrix(int n)
+{
+    DistMatrix *matrix = (DistMatrix *)calloc(1, sizeof(DistMatrix));
+    if (!matrix)
+    {
+        printf("Erreur : allocation mémoire échouée pour la matrice de distances.\n");
+        return NULL;
+    }
+
+    int perLine = DIST_MATRIX_ALIGN / sizeof(float);
+    matrix->n = n;
+    matrix->stride = (n + perLine - 1) / perLine * perLine;
+    matrix->bytes = (size_t)n * matrix->stride * sizeof(float);
+    if (matrix->bytes == 0)
+        matrix->bytes = DIST_MATRIX_ALIGN;
+
+#ifdef _WIN32
+    matrix->data = (float *)_aligned_malloc(matrix->bytes, DIST_MATRIX_ALIGN);
+#else
+#ifdef MADV_HUGEPAGE
+    if (matrix->bytes >= DIST_MATRIX_HUGE)
+    {
+        void *addr = mmap(NULL, matrix->bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr != MAP_FAILED)
+        {
+            madvise(addr, matrix->bytes, MADV_HUGEPAGE); // simple conseil au noyau
+            matrix->data = (float *)addr;
+            matrix->mapped = true;
+        }
+    }
+#endif
+    if (!matrix->data)
+    {
+        void *addr = NULL;
+        if (posix_memalign(&addr, DIST_MATRIX_ALIGN, matrix->bytes) == 0)
+            matrix->data = (float *)addr;
+    }
+#endif
+
+    if (!matrix->data)
+    {
+        printf("Erreur : allocation mémoire échouée pour une matrice %d x %d (%.1f Mo).\n",
+               n, n, matrix->bytes / (1024.0 * 1024.0));
+        free(matrix);
+        return NULL;
+    }
+    return matrix;
+}
+
+// Fonction pour libérer une matrice de distances
+void freeDistMatrix(DistMatrix *matrix)
+{
+    if (!matrix)
+        return;
+#ifdef _WIN32
+    _aligned_free(matrix->data);
+#else
+    if (matrix->mapped)
+        munmap(matrix->data, matrix->bytes);
+    else
+        free(matrix->data);
+#endif
+    free(matrix);
+}
+
+// Adresse de la ligne i
+float *distMatrixRow(const DistMatrix *matrix, int i)
+{
+    return matrix->data + (size_t)i * matrix->stride;
+}
+
+// Fonction pour trouver le chemin le plus court entre tous les paires de sommets
+void floydWarshall(Graph *graph, DistMatrix *dist)
+{
+    int V = graph->V;
+
+    // Initialisation
+    for (int i = 0; i < V; i++)
+    {
+        float *row = distMatrixRow(dist, i);
+        for (int j = 0; j < V; j++)
+        {
+            row[j] = (i == j) ? 0 : INF;
+        }
+
+        AdjListNode *pCrawl = graph->array[i].head;
+        while (pCrawl)
+        {
+            row[pCrawl->dest] = pCrawl->attr.distance; // ou baseTime / cost selon le critère
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    // Algorithme de Floyd-Warshall
+    for (int k = 0; k < V; k++)
+    {
+        const float *rowK = distMatrixRow(dist, k);
+        for (int i = 0; i < V; i++)
+        {
+            float *rowI = distMatrixRow(dist, i);
+            for (int j = 0; j < V; j++)
+            {
+                if (rowI[k] + rowK[j] < rowI[j])
+                    rowI[j] = rowI[k] + rowK[j];
+            }
+        }
+    }
+}
+
+// Fonction pour afficher les distances
+void printFloydWarshall(Graph *graph, const DistMatrix *dist)
+{
+    printf("\n===== Plus courts chemins entre toutes les paires de villes (en km) - FLOYD WARSHALL =====\n");
+
+    for (int i = 0; i < graph->V; i++)
+    {
+        const float *row = distMatrixRow(dist, i);
+        for (int j = 0; j < graph->V; j++)
+        {
+            printf("De %-15s à %-15s : ", graph->cityNames[i], graph->cityNames[j]);
+            if (row[j] == INF)
+                printf("Aucun chemin\n");
+            else
+                printf("%.2f km\n", row[j]);
+        }
+        printf("\n");
+    }
+}
+
+void floydWarshallCSR(const CSRGraph *csr, DistMatrix *dist)
+{
+    floydWarshallInitCSR(csr, dist);
+    floydWarshallParallel(dist->data, dist->n, dist->stride, FW_KERNEL_AUTO, 0);
+}
+
+// Initialisation de la matrice à partir des arêtes du CSR
+void floydWarshallInitCSR(const CSRGraph *csr, DistMatrix *dist)
+{
+    int V = csr->V;
+    for (int i = 0; i < V; i++)
+    {
+        float *row = distMatrixRow(dist, i);
+        for (int j = 0; j < V; j++)
+        {
+            row[j] = (i == j) ? 0 : INF;
+        }
+
+        for (int e = csr->offsets[i]; e < csr->offsets[i + 1]; e++)
+        {
+            row[csr->dest[e]] = csr->distance[e]; // ou baseTime / cost selon le critère
+        }
+    }
+}
+
+// Mise à jour d'une tuile [i0,i1[ x [j0,j1[ par les pivots [k0,k1[ :
+// dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j])
+static void fwTileScalaire(float *dist, int ld, int i0, int i1, int j0, int j1, int k0, int k1)
+{
+    for (int k = k0; k < k1; k++)
+    {
+        const float *rowK = dist + (size_t)k * ld;
+        for (int i = i0; i < i1; i++)
+        {
+            float *rowI = dist + (size_t)i * ld;
+            float dik = rowI[k];
+            for (int j = j0; j < j1; j++)
+            {
+                float d = dik + rowK[j];
+                if (d < rowI[j])
+                    rowI[j] = d;
+            }
+        }
+    }
+}
+
+#ifdef FW_SIMD_X86
+// _mm_min_ps(a, b) retourne b sauf si a < b : même résultat que le test scalaire
+__attribute__((target("sse2"))) static void fwTileSSE(float *dist, int ld, int i0, int i1, int j0, int j1, int k0, int k1)
+{
+    for (int k = k0; k < k1; k++)
+    {
+        const float *rowK = dist + (size_t)k * ld;
+        for (int i = i0; i < i1; i++)
+        {
+            float *rowI = dist + (size_t)i * ld;
+            float dik = rowI[k];
+            __m128 vik = _mm_set1_ps(dik);
+            int j = j0;
+            for (; j + 4 <= j1; j += 4)
+            {
+                __m128 d = _mm_add_ps(vik, _mm_loadu_ps(rowK + j));
+                _mm_storeu_ps(rowI + j, _mm_min_ps(d, _mm_loadu_ps(rowI + j)));
+            }
+            for (; j < j1; j++)
+            {
+                float d = dik + rowK[j];
+                if (d < rowI[j])
+                    rowI[j] = d;
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2"))) static void fwTileAVX2(float *dist, int ld, int i0, int i1, int j0, int j1, int k0, int k1)
+{
+    for (int k = k0; k < k1; k++)
+    {
+        const float *rowK = dist + (size_t)k * ld;
+        for (int i = i0; i < i1; i++)
+        {
+            float *rowI = dist + (size_t)i * ld;
+            float dik = rowI[k];
+            __m256 vik = _mm256_set1_ps(dik);
+            int j = j0;
+            for (; j + 8 <= j1; j += 8)
+            {
+                __m256 d = _mm256_add_ps(vik, _mm256_loadu_ps(rowK + j));
+                _mm256_storeu_ps(rowI + j, _mm256_min_ps(d, _mm256_loadu_ps(rowI + j)));
+            }
+            for (; j < j1; j++)
+            {
+                float d = dik + rowK[j];
+                if (d < rowI[j])
+                    rowI[j] = d;
+            }
+        }
+    }
+}
+#endif
+
+// Remplace FW_KERNEL_AUTO (ou un noyau non supporté) par le meilleur noyau disponible
+FWKernel floydWarshallResolveKernel(FWKernel kernel)
+{
+#ifdef FW_SIMD_X86
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2");
+    bool sse = __builtin_cpu_supports("sse2");
+#else
+    bool avx2 = false, sse = false;
+#endif
+    if (kernel == FW_KERNEL_AVX2 && !avx2)
+        kernel = FW_KERNEL_AUTO;
+    if (kernel == FW_KERNEL_SSE && !sse)
+        kernel = FW_KERNEL_AUTO;
+    if (kernel == FW_KERNEL_AUTO)
+        kernel = avx2 ? FW_KERNEL_AVX2 : sse ? FW_KERNEL_SSE : FW_KERNEL_SCALAIRE;
+    return kernel;
+}
+
+const char *floydWarshallKernelName(FWKernel kernel)
+{
+    switch (kernel)
+    {
+    case FW_KERNEL_SCALAIRE:
+        return "scalaire";
+    case FW_KERNEL_SSE:
+        return "sse";
+    case FW_KERNEL_AVX2:
+        return "avx2";
+    default:
+        return "auto";
+    }
+}
+
+// Fonction pour appliquer Floyd-Warshall par tuiles de FW_BLOCK x FW_BLOCK.
+// Pour chaque bloc de pivots kb : (1) la tuile diagonale, (2) les tuiles de la
+// ligne et de la colonne kb, qui ne dépendent que de la diagonale, (3) toutes les
+// autres tuiles, qui ne dépendent que de la ligne et de la colonne. Chaque tuile
+// reste en cache pendant ses FW_BLOCK pivots au lieu de balayer toute la matrice.
+// Les distances obtenues sont celles de l'algorithme classique ; seules les sommes
+// intermédiaires peuvent être associées différemment (écart d'arrondi flottant
+// possible au dernier bit, nul lorsque les poids sont entiers).
+void floydWarshallBlocked(float *dist, int V, int ld, FWKernel kernel)
+{
+    floydWarshallParallel(dist, V, ld, kernel, 1);
+}
+
+// Nombre de threads disponibles (1 sans OpenMP)
+int nombreThreadsMax(void)
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Version multi-thread : à l'intérieur d'une phase, les tuiles sont indépendantes
+// (chacune n'écrit que dans elle-même et ne lit que la diagonale, la ligne ou la
+// colonne du bloc de pivots), elles sont donc réparties entre les threads avec une
+// barrière entre les phases. nbThreads <= 0 : tous les cœurs disponibles.
+void floydWarshallParallel(float *dist, int V, int ld, FWKernel kernel, int nbThreads)
+{
+    void (*tile)(float *, int, int, int, int, int, int, int) = fwTileScalaire;
+#ifdef FW_SIMD_X86
+    kernel = floydWarshallResolveKernel(kernel);
+    if (kernel == FW_KERNEL_AVX2)
+        tile = fwTileAVX2;
+    else if (kernel == FW_KERNEL_SSE)
+        tile = fwTileSSE;
+#else
+    (void)kernel;
+#endif
+
+    int nbBlocks = (V + FW_BLOCK - 1) / FW_BLOCK;
+    if (nbThreads <= 0)
+        nbThreads = nombreThreadsMax();
+    if (nbThreads > nbBlocks * nbBlocks)
+        nbThreads = nbBlocks * nbBlocks > 0 ? nbBlocks * nbBlocks : 1;
+    (void)nbThreads;
+
+    OMP_PRAGMA(omp parallel num_threads(nbThreads))
+    for (int kb = 0; kb < nbBlocks; kb++)
+    {
+        int k0 = kb * FW_BLOCK;
+        int k1 = k0 + FW_BLOCK < V ? k0 + FW_BLOCK : V;
+
+        // Phase 1 : tuile diagonale
+        OMP_PRAGMA(omp single)
+        tile(dist, ld, k0, k1, k0, k1, k0, k1);
+
+        // Phase 2 : ligne et colonne du bloc de pivots
+        OMP_PRAGMA(omp for schedule(static))
+        for (int b = 0; b < 2 * nbBlocks; b++)
+        {
+            int bb = b / 2;
+            if (bb == kb)
+                continue;
+            int b0 = bb * FW_BLOCK;
+            int b1 = b0 + FW_BLOCK < V ? b0 + FW_BLOCK : V;
+            if (b % 2 == 0)
+                tile(dist, ld, k0, k1, b0, b1, k0, k1);
+            else
+                tile(dist, ld, b0, b1, k0, k1, k0, k1);
+        }
+
+        // Phase 3 : tuiles restantes
+        OMP_PRAGMA(omp for collapse(2) schedule(static))
+        for (int ib = 0; ib < nbBlocks; ib++)
+        {
+            for (int jb = 0; jb < nbBlocks; jb++)
+            {
+                if (ib == kb || jb == kb)
+                    continue;
+                int i0 = ib * FW_BLOCK;
+                int i1 = i0 + FW_BLOCK < V ? i0 + FW_BLOCK : V;
+                int j0 = jb * FW_BLOCK;
+                int j1 = j0 + FW_BLOCK < V ? j0 + FW_BLOCK : V;
+                tile(dist, ld, i0, i1, j0, j1, k0, k1);
+            }
+        }
+    }
+}
+
+void printFloydWarshallCSR(const CSRGraph *csr, const DistMatrix *dist)
+{
+    printf("\n===== Plus courts chemins entre toutes les paires de villes (en km) - FLOYD WARSHALL =====\n");
+
+    for (int i = 0; i < csr->V; i++)
+    {
+        const float *row = distMatrixRow(dist, i);
+        for (int j = 0; j < csr->V; j++)
+        {
+            printf("De %-15s à %-15s : ", csrCityName(csr, i), csrCityName(csr, j));
+            if (row[j] == INF)
+                printf("Aucun chemin\n");
+            else
+                printf("%.2f km\n", row[j]);
+        }
+        printf("\n");
+    }
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> BELLMAN-FORD ALGORITHM
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Fonction pour trouver le chemin le plus court à partir d'une source
+void bellmanFord(Graph *graph, int src, float *dist, int *pred, float maxTime)
+{
+    int V = graph->V;
+    float *time = (float *)malloc(V * sizeof(float)); // Array to track cumulative time
+    if (!time)
+    {
+        printf("Erreur : allocation mémoire échouée pour le tableau des temps.\n");
+        return;
+    }
+
+    // Initialisation
+    for (int i = 0; i < V; i++)
+    {
+        dist[i] = INF;
+        time[i] = INF;
+        pred[i] = -1;
+    }
+    dist[src] = 0;
+    time[src] = 0;
+
+    // Relaxation des arêtes V-1 fois (au plus : arrêt dès qu'une passe ne change rien)
+    bool changed = true;
+    for (int i = 1; i <= V - 1 && changed; i++)
+    {
+        changed = false;
+        for (int u = 0; u < V; u++)
+        {
+            if (dist[u] == INF)
+                continue; // sommet pas encore atteint (INF + poids négatif < INF sinon)
+
+            AdjListNode *node = graph->array[u].head;
+            while (node)
+            {
+                int v = node->dest;
+
+                // float weight = node->attr.cost + 10 * node->attr.toll;
+                float weight = node->attr.cost;
+                float edgeTime = node->attr.baseTime;
+
+                // Appliquer une contrainte sur le temps
+                if (time[u] + edgeTime <= maxTime && dist[u] + weight < dist[v])
+                {
+                    dist[v] = dist[u] + weight;
+                    time[v] = time[u] + edgeTime; // Update cumulative time
+                    pred[v] = u;
+                    changed = true;
+                }
+
+                node = node->next;
+            }
+        }
+    }
+
+    // Vérification des cycles négatifs (inutile si la dernière passe n'a rien changé)
+    for (int u = 0; u < V && changed; u++)
+    {
+        AdjListNode *node = graph->array[u].head;
+        while (node)
+        {
+            int v = node->dest;
+            // float weight = node->attr.cost + 10 * node->attr.toll;
+            float weight = node->attr.cost;
+            float edgeTime = node->attr.baseTime;
+
+            if (dist[u] != INF && time[u] + edgeTime <= maxTime && dist[u] + weight < dist[v])
+            {
+                printf("Attention : présence d’un cycle de poids négatif.\n");
+                free(time);
+                return;
+            }
+
+            node = node->next;
+        }
+    }
+
+    free(time);
+}
+
+// Fonction pour afficher le chemin le plus court
+void printBellmanFord(Graph *graph, int src, float *dist, int *pred)
+{
+    printf("\n===== Chemins optimaux depuis %s (BELLMAN-FORD) =====\n", graph->cityNames[src]);
+
+    int *path = (int *)malloc(graph->V * sizeof(int));
+    if (!path)
+    {
+        printf("Erreur : allocation mémoire échouée pour le chemin.\n");
+        return;
+    }
+
+    for (int i = 0; i < graph->V; i++)
+    {
+        printf("Vers %-15s : ", graph->cityNames[i]);
+
+        if (dist[i] == INF)
+        {
+            printf("Aucun chemin respectant les contraintes.\n");
+        }
+        else
+        {
+            float totalTime = 0;
+            float totalCost = 0;
+            int count = 0;
+
+            for (int v = i; v != -1; v = pred[v])
+                path[count++] = v;
+
+            for (int j = count - 1; j > 0; j--)
+            {
+                AdjListNode *node = graph->array[path[j]].head;
+                while (node && node->dest != path[j - 1])
+                    node = node->next;
+
+                if (node)
+                {
+                    totalTime += node->attr.baseTime;
+                    totalCost += node->attr.cost; // instead of node->attr.cost + 10 * node->attr.toll
+                }
+            }
+
+            printf("Temps = %.2f, Cout = %.2f XOF, Chemin = ", totalTime, totalCost);
+            for (int j = count - 1; j >= 0; j--)
+            {
+                printf("%s", graph->cityNames[path[j]]);
+                if (j > 0)
+                    printf(" -> ");
+            }
+            printf("\n");
+        }
+    }
+
+    free(path);
+}
+
+void bellmanFordCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime)
+{
+    int V = csr->V;
+    float *time = (float *)malloc(V * sizeof(float)); // temps cumulé
+    if (!time)
+    {
+        printf("Erreur : allocation mémoire échouée pour le tableau des temps.\n");
+        return;
+    }
+
+    // Initialisation
+    for (int i = 0; i < V; i++)
+    {
+        dist[i] = INF;
+        time[i] = INF;
+        pred[i] = -1;
+    }
+    dist[src] = 0;
+    time[src] = 0;
+
+    // Relaxation des arêtes V-1 fois : chaque passe lit les colonnes cost/baseTime/dest
+    // de façon séquentielle au lieu de suivre les pointeurs des listes chaînées.
+    // Une passe sans aucune relaxation signifie que les étiquettes sont stables : les
+    // passes suivantes ne changeraient rien, on s'arrête.
+    bool changed = true;
+    for (int i = 1; i <= V - 1 && changed; i++)
+    {
+        changed = false;
+        for (int u = 0; u < V; u++)
+        {
+            if (dist[u] == INF)
+                continue; // sommet pas encore atteint (INF + poids négatif < INF sinon)
+
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+            {
+                int v = csr->dest[e];
+                float weight = csr->cost[e];
+                float edgeTime = csr->baseTime[e];
+
+                if (time[u] + edgeTime <= maxTime && dist[u] + weight < dist[v])
+                {
+                    dist[v] = dist[u] + weight;
+                    time[v] = time[u] + edgeTime;
+                    pred[v] = u;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Vérification des cycles négatifs (inutile si la dernière passe n'a rien changé)
+    for (int u = 0; u < V && changed; u++)
+    {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+        {
+            int v = csr->dest[e];
+            if (dist[u] != INF && time[u] + csr->baseTime[e] <= maxTime && dist[u] + csr->cost[e] < dist[v])
+            {
+                printf("Attention : présence d’un cycle de poids négatif.\n");
+                free(time);
+                return;
+            }
+        }
+    }
+
+    free(time);
+}
+
+// Variante à file (SPFA) : seuls les sommets dont l'étiquette vient de baisser sont
+// re-balayés, au lieu de toutes les arêtes à chaque passe. Heuristique SLF (Small
+// Label First) : un sommet dont le coût est inférieur à celui de la tête de file est
+// inséré en tête. Détection des cycles négatifs : si le chemin de prédécesseurs d'un
+// sommet atteint V arêtes, il contient forcément un cycle de poids négatif.
+// Mêmes entrées/sorties que bellmanFordCSR ; retourne false si un cycle est détecté.
+bool spfaCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime)
+{
+    int V = csr->V;
+    float *time = (float *)malloc(V * sizeof(float));
+    int *length = (int *)malloc(V * sizeof(int)); // nombre d'arêtes du chemin courant
+    int *deque = (int *)malloc(V * sizeof(int));  // file circulaire (chaque sommet au plus une fois)
+    bool *inQueue = (bool *)calloc(V, sizeof(bool));
+    if (!time || !length || !deque || !inQueue)
+    {
+        printf("Erreur : allocation mémoire échouée pour SPFA.\n");
+        free(time);
+        free(length);
+        free(deque);
+        free(inQueue);
+        return false;
+    }
+
+    for (int i = 0; i < V; i++)
+    {
+        dist[i] = INF;
+        time[i] = INF;
+        pred[i] = -1;
+        length[i] = 0;
+    }
+    dist[src] = 0;
+    time[src] = 0;
+
+    int head = 0, size = 0;
+    deque[0] = src;
+    size = 1;
+    inQueue[src] = true;
+
+    bool ok = true;
+    while (size > 0 && ok)
+    {
+        int u = deque[head];
+        head = (head + 1) % V;
+        size--;
+        inQueue[u] = false;
+
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+        {
+            int v = csr->dest[e];
+            float weight = csr->cost[e];
+            float edgeTime = csr->baseTime[e];
+
+            if (time[u] + edgeTime <= maxTime && dist[u] + weight < dist[v])
+            {
+                dist[v] = dist[u] + weight;
+                time[v] = time[u] + edgeTime;
+                pred[v] = u;
+                length[v] = length[u] + 1;
+                if (length[v] >= V)
+                {
+                    printf("Attention : présence d’un cycle de poids négatif.\n");
+                    ok = false;
+                    break;
+                }
+
+                if (!inQueue[v])
+                {
+                    inQueue[v] = true;
+                    if (size > 0 && dist[v] < dist[deque[head]])
+                    {
+                        head = (head + V - 1) % V; // SLF : insertion en tête
+                        deque[head] = v;
+                    }
+                    else
+                    {
+                        deque[(head + size) % V] = v;
+                    }
+                    size++;
+                }
+            }
+        }
+    }
+
+    free(time);
+    free(length);
+    free(deque);
+    free(inQueue);
+    return ok;
+}
+
+void printBellmanFordCSR(const CSRGraph *csr, int src, float *dist, int *pred)
+{
+    printShortestPathsCSR(csr, src, dist, pred, "BELLMAN-FORD");
+}
+
+// Affichage commun aux algorithmes à source unique (algorithm : nom affiché)
+void printShortestPathsCSR(const CSRGraph *csr, int src, float *dist, int *pred, const char *algorithm)
+{
+    printf("\n===== Chemins optimaux depuis %s (%s) =====\n", csrCityName(csr, src), algorithm);
+
+    int *path = (int *)malloc(csr->V * sizeof(int));
+    if (!path)
+    {
+        printf("Erreur : allocation mémoire échouée pour le chemin.\n");
+        return;
+    }
+
+    for (int i = 0; i < csr->V; i++)
+    {
+        printf("Vers %-15s : ", csrCityName(csr, i));
+
+        if (dist[i] == INF)
+        {
+            printf("Aucun chemin respectant les contraintes.\n");
+        }
+        else
+        {
+            float totalTime = 0;
+            float totalCost = 0;
+            int count = 0;
+
+            for (int v = i; v != -1; v = pred[v])
+                path[count++] = v;
+
+            for (int j = count - 1; j > 0; j--)
+            {
+                int e = csr->offsets[path[j]];
+                while (e < csr->offsets[path[j] + 1] && csr->dest[e] != path[j - 1])
+                    e++;
+
+                if (e < csr->offsets[path[j] + 1])
+                {
+                    totalTime += csr->baseTime[e];
+                    totalCost += csr->cost[e];
+                }
+            }
+
+            printf("Temps = %.2f, Cout = %.2f XOF, Chemin = ", totalTime, totalCost);
+            for (int j = count - 1; j >= 0; j--)
+            {
+                printf("%s", csrCityName(csr, path[j]));
+                if (j > 0)
+                    printf(" -> ");
+            }
+            printf("\n");
+        }
+    }
+
+    free(path);
+}
+
+// Fonction pour allouer les étiquettes d'un lot de K sources sur V sommets
+MultiSourcePaths *createMultiSourcePaths(int V, int K)
+{
+    MultiSourcePaths *paths = (MultiSourcePaths *)calloc(1, sizeof(MultiSourcePaths));
+    if (!paths)
+    {
+        printf("Erreur : allocation mémoire échouée pour le lot de sources.\n");
+        return NULL;
+    }
+    paths->V = V;
+    paths->K = K;
+    paths->stride = (K + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES;
+    size_t cells = (size_t)V * paths->stride;
+    paths->dist = (float *)malloc(cells * sizeof(float));
+    paths->time = (float *)malloc(cells * sizeof(float));
+    paths->pred = (int *)malloc(cells * sizeof(int));
+    if (!paths->dist || !paths->time || !paths->pred)
+    {
+        printf("Erreur : allocation mémoire échouée pour le lot de sources.\n");
+        freeMultiSourcePaths(paths);
+        return NULL;
+    }
+    return paths;
+}
+
+void freeMultiSourcePaths(MultiSourcePaths *paths)
+{
+    if (!paths)
+        return;
+    free(paths->dist);
+    free(paths->time);
+    free(paths->pred);
+    free(paths);
+}
+
+// Relâche l'arête u -> v (coût w, temps bt) pour les n sources d'un sommet.
+// Même test que bellmanFordCSR, écrit sans branchement pour être vectorisable.
+// Retourne true si au moins une source a été améliorée.
+static bool relaxLanesScalaire(const float *du, const float *tu, float *dv, float *tv, int *pv, int u, float w,
+                               float bt, float maxTime, int n)
+{
+    int any = 0;
+    for (int s = 0; s < n; s++)
+    {
+        float nd = du[s] + w;
+        float nt = tu[s] + bt;
+        int better = (du[s] < (float)INF) & (nt <= maxTime) & (nd < dv[s]);
+        dv[s] = better ? nd : dv[s];
+        tv[s] = better ? nt : tv[s];
+        pv[s] = better ? u : pv[s];
+        any |= better;
+    }
+    return any;
+}
+
+#ifdef FW_SIMD_X86
+__attribute__((target("avx2"))) static bool relaxLanesAVX2(const float *du, const float *tu, float *dv, float *tv,
+                                                             int *pv, int u, float w, float bt, float maxTime, int n)
+{
+    __m256 vw = _mm256_set1_ps(w);
+    __m256 vbt = _mm256_set1_ps(bt);
+    __m256 vmax = _mm256_set1_ps(maxTime);
+    __m256 vinf = _mm256_set1_ps((float)INF);
+    __m256 vu = _mm256_castsi256_ps(_mm256_set1_epi32(u));
+    int any = 0;
+    for (int s = 0; s < n; s += 8)
+    {
+        __m256 d = _mm256_loadu_ps(du + s);
+        __m256 nd = _mm256_add_ps(d, vw);
+        __m256 nt = _mm256_add_ps(_mm256_loadu_ps(tu + s), vbt);
+        __m256 old = _mm256_loadu_ps(dv + s);
+        __m256 better = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(d, vinf, _CMP_LT_OQ), _mm256_cmp_ps(nt, vmax, _CMP_LE_OQ)),
+                                      _mm256_cmp_ps(nd, old, _CMP_LT_OQ));
+        if (_mm256_movemask_ps(better) == 0)
+            continue;
+        _mm256_storeu_ps(dv + s, _mm256_blendv_ps(old, nd, better));
+        _mm256_storeu_ps(tv + s, _mm256_blendv_ps(_mm256_loadu_ps(tv + s), nt, better));
+        __m256 p = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *)(pv + s)));
+        _mm256_storeu_si256((__m256i *)(pv + s), _mm256_castps_si256(_mm256_blendv_ps(p, vu, better)));
+        any = 1;
+    }
+    return any;
+}
+#endif
+
+// Fonction pour calculer en une seule série de passes les chemins de coût minimal depuis
+// les paths->K sources de sources[], avec la même contrainte maxTime que bellmanFordCSR
+// (et exactement les mêmes résultats, source par source). Chaque arête est lue une fois
+// par passe pour tout le lot au lieu d'une fois par source ; seuls les sommets dont une
+// étiquette a changé depuis leur dernier parcours sont reparcourus. Retourne false si un
+// cycle de poids négatif est détecté.
+bool bellmanFordBatchCSR(const CSRGraph *csr, const int *sources, float maxTime, MultiSourcePaths *paths)
+{
+    int V = csr->V;
+    int stride = paths->stride;
+    bool *dirty = (bool *)calloc(V, sizeof(bool)); // étiquette modifiée depuis le dernier parcours
+    if (!dirty)
+    {
+        printf("Erreur : allocation mémoire échouée pour le lot de sources.\n");
+        return false;
+    }
+
+    size_t cells = (size_t)V * stride;
+    for (size_t i = 0; i < cells; i++)
+    {
+        paths->dist[i] = INF;
+        paths->time[i] = INF;
+        paths->pred[i] = -1;
+    }
+    for (int s = 0; s < paths->K; s++)
+    {
+        paths->dist[(size_t)sources[s] * stride + s] = 0;
+        paths->time[(size_t)sources[s] * stride + s] = 0;
+        dirty[sources[s]] = true;
+    }
+
+    bool (*relax)(const float *, const float *, float *, float *, int *, int, float, float, float, int) = relaxLanesScalaire;
+#ifdef FW_SIMD_X86
+    if (floydWarshallResolveKernel(FW_KERNEL_AUTO) == FW_KERNEL_AVX2)
+        relax = relaxLanesAVX2;
+#endif
+
+    bool changed = true;
+    for (int i = 1; i <= V - 1 && changed; i++)
+    {
+        changed = false;
+        for (int u = 0; u < V; u++)
+        {
+            if (!dirty[u])
+                continue;
+            dirty[u] = false;
+
+            const float *du = paths->dist + (size_t)u * stride;
+            const float *tu = paths->time + (size_t)u * stride;
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+            {
+                size_t v = (size_t)csr->dest[e] * stride;
+                if (relax(du, tu, paths->dist + v, paths->time + v, paths->pred + v, u, csr->cost[e],
+                          csr->baseTime[e], maxTime, stride))
+                {
+                    dirty[csr->dest[e]] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Vérification des cycles négatifs : seuls les sommets modifiés par la dernière passe
+    // peuvent encore relâcher une arête (une étiquette fixée à la passe V-1 est légitime)
+    bool negativeCycle = false;
+    for (int u = 0; u < V && changed && !negativeCycle; u++)
+    {
+        if (!dirty[u])
+            continue;
+        const float *du = paths->dist + (size_t)u * stride;
+        const float *tu = paths->time + (size_t)u * stride;
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1] && !negativeCycle; e++)
+        {
+            const float *dv = paths->dist + (size_t)csr->dest[e] * stride;
+            for (int s = 0; s < paths->K && !negativeCycle; s++)
+                negativeCycle = du[s] < INF && tu[s] + csr->baseTime[e] <= maxTime && du[s] + csr->cost[e] < dv[s];
+        }
+    }
+    if (negativeCycle)
+        printf("Attention : présence d’un cycle de poids négatif.\n");
+
+    free(dirty);
+    return !negativeCycle;
+}
+
+// Copie les résultats de la source s du lot dans des tableaux dist/pred classiques
+void multiSourceColumn(const MultiSourcePaths *paths, int s, float *dist, int *pred)
+{
+    for (int v = 0; v < paths->V; v++)
+    {
+        dist[v] = paths->dist[(size_t)v * paths->stride + s];
+        pred[v] = paths->pred[(size_t)v * paths->stride + s];
+    }
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> DIJKSTRA ALGORITHM
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Fonction pour créer un tas d-aire indexé pouvant contenir les sommets 0..capacity-1
+IndexedHeap *createIndexedHeap(int capacity)
+{
+    IndexedHeap *heap = (IndexedHeap *)malloc(sizeof(IndexedHeap));
+    if (!heap)
+    {
+        printf("Erreur : allocation mémoire échouée pour le tas.\n");
+        return NULL;
+    }
+    heap->size = 0;
+    heap->capacity = capacity;
+    heap->items = (int *)malloc(capacity * sizeof(int));
+    heap->keys = (float *)malloc(capacity * sizeof(float));
+    heap->pos = (int *)malloc(capacity * sizeof(int));
+    if (!heap->items || !heap->keys || !heap->pos)
+    {
+        printf("Erreur : allocation mémoire échouée pour le tas.\n");
+        freeIndexedHeap(heap);
+        return NULL;
+    }
+    for (int i = 0; i < capacity; i++)
+        heap->pos[i] = -1;
+    return heap;
+}
+
+void freeIndexedHeap(IndexedHeap *heap)
+{
+    if (!heap)
+        return;
+    free(heap->items);
+    free(heap->keys);
+    free(heap->pos);
+    free(heap);
+}
+
+// Vide le tas en O(taille) : seules les positions des éléments présents sont remises à -1
+void heapClear(IndexedHeap *heap)
+{
+    for (int i = 0; i < heap->size; i++)
+        heap->pos[heap->items[i]] = -1;
+    heap->size = 0;
+}
+
+static void heapSiftUp(IndexedHeap *heap, int i)
+{
+    int item = heap->items[i];
+    float key = heap->keys[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) / HEAP_ARITY;
+        if (heap->keys[parent] <= key)
+            break;
+        heap->items[i] = heap->items[parent];
+        heap->keys[i] = heap->keys[parent];
+        heap->pos[heap->items[i]] = i;
+        i = parent;
+    }
+    heap->items[i] = item;
+    heap->keys[i] = key;
+    heap->pos[item] = i;
+}
+
+static void heapSiftDown(IndexedHeap *heap, int i)
+{
+    int item = heap->items[i];
+    float key = heap->keys[i];
+    for (;;)
+    {
+        int first = i * HEAP_ARITY + 1;
+        if (first >= heap->size)
+            break;
+        int last = first + HEAP_ARITY < heap->size ? first + HEAP_ARITY : heap->size;
+        int best = first;
+        for (int c = first + 1; c < last; c++)
+        {
+            if (heap->keys[c] < heap->keys[best])
+                best = c;
+        }
+        if (heap->keys[best] >= key)
+            break;
+        heap->items[i] = heap->items[best];
+        heap->keys[i] = heap->keys[best];
+        heap->pos[heap->items[i]] = i;
+        i = best;
+    }
+    heap->items[i] = item;
+    heap->keys[i] = key;
+    heap->pos[item] = i;
+}
+
+// Insère v avec la clé key, ou diminue sa clé s'il est déjà présent
+void heapPushOrDecrease(IndexedHeap *heap, int v, float key)
+{
+    int i = heap->pos[v];
+    if (i < 0)
+    {
+        i = heap->size++;
+        heap->items[i] = v;
+        heap->keys[i] = key;
+        heap->pos[v] = i;
+    }
+    else if (key < heap->keys[i])
+    {
+        heap->keys[i] = key;
+    }
+    else
+    {
+        return;
+    }
+    heapSiftUp(heap, i);
+}
+
+// Retire et retourne le sommet de clé minimale (-1 si le tas est vide)
+int heapPopMin(IndexedHeap *heap)
+{
+    if (heap->size == 0)
+        return -1;
+    int top = heap->items[0];
+    heap->pos[top] = -1;
+    heap->size--;
+    if (heap->size > 0)
+    {
+        heap->items[0] = heap->items[heap->size];
+        heap->keys[0] = heap->keys[heap->size];
+        heap->pos[heap->items[0]] = 0;
+        heapSiftDown(heap, 0);
+    }
+    return top;
+}
+
+// Vérifie qu'aucun coût ni temps d'arête n'est négatif (condition d'emploi de Dijkstra)
+bool hasNegativeWeights(const CSRGraph *csr)
+{
+    for (int e = 0; e < csr->E; e++)
+    {
+        if (csr->cost[e] < 0 || csr->baseTime[e] < 0)
+            return true;
+    }
+    return false;
+}
+
+// Fonction pour trouver les chemins de coût minimal depuis src avec Dijkstra.
+// Mêmes entrées/sorties et même contrainte que bellmanFordCSR : une arête u -> v
+// n'est relâchée que si le temps cumulé jusqu'à v reste <= maxTime, et chaque sommet
+// garde une seule étiquette (coût, temps). Les coûts et temps doivent être >= 0.
+// Complexité O(E log V) au lieu de O(V.E).
+void dijkstraCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime)
+{
+    int V = csr->V;
+    float *time = (float *)malloc(V * sizeof(float));
+    IndexedHeap *heap = createIndexedHeap(V);
+    if (!time || !heap)
+    {
+        printf("Erreur : allocation mémoire échouée pour Dijkstra.\n");
+        free(time);
+        freeIndexedHeap(heap);
+        return;
+    }
+
+    for (int i = 0; i < V; i++)
+    {
+        dist[i] = INF;
+        time[i] = INF;
+        pred[i] = -1;
+    }
+    dist[src] = 0;
+    time[src] = 0;
+    heapPushOrDecrease(heap, src, 0);
+
+    int u;
+    while ((u = heapPopMin(heap)) >= 0)
+    {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+        {
+            int v = csr->dest[e];
+            float weight = csr->cost[e];
+            float edgeTime = csr->baseTime[e];
+
+            if (time[u] + edgeTime <= maxTime && dist[u] + weight < dist[v])
+            {
+                dist[v] = dist[u] + weight;
+                time[v] = time[u] + edgeTime;
+                pred[v] = u;
+                heapPushOrDecrease(heap, v, dist[v]);
+            }
+        }
+    }
+
+    free(time);
+    freeIndexedHeap(heap);
+}
+
+const char *shortestPathModeName(ShortestPathMode mode)
+{
+    switch (mode)
+    {
+    case SP_DIJKSTRA:
+        return "DIJKSTRA";
+    case SP_BELLMAN_FORD:
+        return "BELLMAN-FORD";
+    case SP_SPFA:
+        return "BELLMAN-FORD (SPFA)";
+    default:
+        return "AUTO";
+    }
+}
+
+// Fonction pour calculer les chemins optimaux depuis src avec l'algorithme demandé.
+// En mode SP_AUTO, Dijkstra est utilisé sauf si une arête de poids négatif est
+// détectée, auquel cas on revient à Bellman-Ford (variante SPFA). Retourne
+// l'algorithme employé.
+ShortestPathMode shortestPathsCSR(const CSRGraph *csr, int src, float *dist, int *pred, float maxTime, ShortestPathMode mode)
+{
+    if (mode == SP_AUTO)
+        mode = hasNegativeWeights(csr) ? SP_SPFA : SP_DIJKSTRA;
+
+    if (mode == SP_DIJKSTRA)
+        dijkstraCSR(csr, src, dist, pred, maxTime);
+    else if (mode == SP_SPFA)
+        spfaCSR(csr, src, dist, pred, maxTime);
+    else
+        bellmanFordCSR(csr, src, dist, pred, maxTime);
+    return mode;
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> PLUS COURT CHEMIN SOUS CONTRAINTE DE RESSOURCE (ETIQUETTES DE PARETO)
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Fonction pour créer un réservoir d'étiquettes pour un graphe de V sommets
+RCSPLabels *createRCSPLabels(int V)
+{
+    RCSPLabels *labels = (RCSPLabels *)calloc(1, sizeof(RCSPLabels));
+    if (!labels)
+    {
+        printf("Erreur : allocation mémoire échouée pour les étiquettes.\n");
+        return NULL;
+    }
+    labels->V = V;
+    labels->head = (int *)malloc(V * sizeof(int));
+    if (!labels->head)
+    {
+        printf("Erreur : allocation mémoire échouée pour les étiquettes.\n");
+        free(labels);
+        return NULL;
+    }
+    for (int v = 0; v < V; v++)
+        labels->head[v] = -1;
+    return labels;
+}
+
+void freeRCSPLabels(RCSPLabels *labels)
+{
+    if (!labels)
+        return;
+    free(labels->node);
+    free(labels->parent);
+    free(labels->cost);
+    free(labels->time);
+    free(labels->next);
+    free(labels->nextAtNode);
+    free(labels->dominated);
+    free(labels->head);
+    free(labels);
+}
+
+// Double la taille du réservoir (les colonnes sont réallouées une à une)
+static bool rcspGrow(RCSPLabels *labels)
+{
+    int capacity = labels->capacity ? labels->capacity * 2 : 1024;
+    void **fields[] = {(void **)&labels->node, (void **)&labels->parent, (void **)&labels->cost,
+                       (void **)&labels->time, (void **)&labels->next, (void **)&labels->nextAtNode};
+    for (int f = 0; f < (int)(sizeof(fields) / sizeof(fields[0])); f++)
+    {
+        void *p = realloc(*fields[f], (size_t)capacity * 4); // colonnes de 4 octets (int ou float)
+        if (!p)
+            return false;
+        *fields[f] = p;
+    }
+    unsigned char *dominated = (unsigned char *)realloc(labels->dominated, capacity);
+    if (!dominated)
+        return false;
+    labels->dominated = dominated;
+    labels->capacity = capacity;
+    return true;
+}
+
+// Insère l'étiquette (c, t) au sommet v si aucune étiquette de v ne la domine.
+// L'ensemble de Pareto de v est une liste triée par coût croissant, donc par temps
+// strictement décroissant : une seule comparaison suffit pour savoir si (c, t) est
+// dominée, et les étiquettes qu'elle domine sont contiguës juste après sa place.
+// Retourne l'indice de la nouvelle étiquette, -1 si elle est dominée, -2 si la mémoire manque.
+static int rcspInsert(RCSPLabels *labels, int v, int parent, float c, float t)
+{
+    int prev = -1;
+    int cur = labels->head[v];
+    while (cur >= 0 && labels->cost[cur] < c)
+    {
+        prev = cur;
+        cur = labels->nextAtNode[cur];
+    }
+    if (prev >= 0 && labels->time[prev] <= t)
+        return -1;
+    if (cur >= 0 && labels->cost[cur] == c && labels->time[cur] <= t)
+        return -1;
+
+    // Les étiquettes suivantes de temps >= t sont dominées par (c, t)
+    while (cur >= 0 && labels->time[cur] >= t)
+    {
+        labels->dominated[cur] = 1;
+        cur = labels->nextAtNode[cur];
+    }
+
+    if (labels->count == labels->capacity && !rcspGrow(labels))
+        return -2;
+    int l = labels->count++;
+    labels->node[l] = v;
+    labels->parent[l] = parent;
+    labels->cost[l] = c;
+    labels->time[l] = t;
+    labels->dominated[l] = 0;
+    labels->nextAtNode[l] = cur;
+    if (prev >= 0)
+        labels->nextAtNode[prev] = l;
+    else
+        labels->head[v] = l;
+    return l;
+}
+
+// Fonction pour trouver les chemins de coût minimal depuis src dont le temps total reste
+// <= maxTime. Contrairement à dijkstraCSR et bellmanFordCSR, qui ne gardent qu'une
+// étiquette (coût, temps) par sommet, chaque sommet garde toutes ses étiquettes
+// Pareto-optimales : un chemin plus cher mais plus rapide vers un sommet intermédiaire
+// n'est plus perdu s'il est le seul à permettre un trajet moins cher plus loin.
+// Les étiquettes sont étendues par coût croissant grâce à une file à seaux circulaire
+// (Dial). À la fin, labels->head[v] est l'étiquette de coût minimal de v, optimale.
+// Si target >= 0, la recherche s'arrête dès que le coût optimal vers target est prouvé ;
+// seul le résultat pour target est alors garanti. Coûts et temps doivent être >= 0.
+bool rcspCSR(const CSRGraph *csr, int src, int target, float maxTime, RCSPLabels *labels)
+{
+    if (hasNegativeWeights(csr))
+    {
+        printf("Erreur : les étiquettes de Pareto exigent des coûts et des temps positifs.\n");
+        return false;
+    }
+
+    float maxCost = 0;
+    for (int e = 0; e < csr->E; e++)
+    {
+        if (csr->cost[e] > maxCost)
+            maxCost = csr->cost[e];
+    }
+    // Une arête ne fait jamais avancer une étiquette de plus de RCSP_BUCKETS - 2 seaux :
+    // la file circulaire ne contient donc jamais deux seaux de même indice à la fois.
+    float width = maxCost > 0 ? maxCost / (RCSP_BUCKETS - 2) : 1.0f;
+    int *buckets = (int *)malloc(RCSP_BUCKETS * sizeof(int));
+    if (!buckets)
+    {
+        printf("Erreur : allocation mémoire échouée pour la file à seaux.\n");
+        return false;
+    }
+    for (int b = 0; b < RCSP_BUCKETS; b++)
+        buckets[b] = -1;
+
+    for (int v = 0; v < labels->V; v++)
+        labels->head[v] = -1;
+    labels->count = 0;
+    labels->settled = 0;
+
+    bool ok = true;
+    int l = rcspInsert(labels, src, -1, 0, 0);
+    if (l < 0)
+    {
+        free(buckets);
+        printf("Erreur : allocation mémoire échouée pour les étiquettes.\n");
+        return false;
+    }
+    labels->next[l] = -1;
+    buckets[0] = l;
+    int pending = 1;
+    long long key = 0; // seau courant (coût / width)
+    float bound = INF; // meilleur coût connu vers target
+
+    while (pending > 0)
+    {
+        int b = (int)(key % RCSP_BUCKETS);
+        if (buckets[b] < 0)
+        {
+            key++;
+            continue;
+        }
+        // Toutes les étiquettes restantes coûtent au moins key * width
+        if (target >= 0 && key * width >= bound)
+            break;
+
+        l = buckets[b];
+        buckets[b] = labels->next[l];
+        pending--;
+        if (labels->dominated[l])
+            continue;
+        labels->settled++;
+
+        int u = labels->node[l];
+        if (u == target)
+            continue;
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+        {
+            float c = labels->cost[l] + csr->cost[e];
+            float t = labels->time[l] + csr->baseTime[e];
+            if (t > maxTime || c >= bound)
+                continue;
+
+            int v = csr->dest[e];
+            int nl = rcspInsert(labels, v, l, c, t);
+            if (nl == -1)
+                continue;
+            if (nl == -2)
+            {
+                printf("Erreur : allocation mémoire échouée pour les étiquettes.\n");
+                ok = false;
+                pending = 0;
+                break;
+            }
+            if (v == target)
+                bound = c;
+
+            int nb = (int)((long long)(c / width) % RCSP_BUCKETS);
+            labels->next[nl] = buckets[nb];
+            buckets[nb] = nl;
+            pending++;
+        }
+    }
+
+    free(buckets);
+    return ok;
+}
+
+// Reconstitue dans path (src d'abord) le chemin de coût minimal vers v.
+// Retourne le nombre de sommets du chemin, 0 si v est inaccessible.
+int rcspPath(const RCSPLabels *labels, int v, int *path)
+{
+    int count = 0;
+    for (int l = labels->head[v]; l >= 0; l = labels->parent[l])
+        path[count++] = labels->node[l];
+    for (int i = 0, j = count - 1; i < j; i++, j--)
+    {
+        int tmp = path[i];
+        path[i] = path[j];
+        path[j] = tmp;
+    }
+    return count;
+}
+
+// Affichage des chemins trouvés par rcspCSR (même présentation que printShortestPathsCSR)
+void printResourceConstrainedPathsCSR(const CSRGraph *csr, int src, const RCSPLabels *labels)
+{
+    printf("\n===== Chemins optimaux depuis %s (ÉTIQUETTES DE PARETO) =====\n", csrCityName(csr, src));
+
+    int *path = (int *)malloc(csr->V * sizeof(int));
+    if (!path)
+    {
+        printf("Erreur : allocation mémoire échouée pour le chemin.\n");
+        return;
+    }
+
+    for (int i = 0; i < csr->V; i++)
+    {
+        printf("Vers %-15s : ", csrCityName(csr, i));
+
+        int best = labels->head[i];
+        if (best < 0)
+        {
+            printf("Aucun chemin respectant les contraintes.\n");
+            continue;
+        }
+
+        int count = rcspPath(labels, i, path);
+        printf("Temps = %.2f, Cout = %.2f XOF, Chemin = ", labels->time[best], labels->cost[best]);
+        for (int j = 0; j < count; j++)
+        {
+            printf("%s", csrCityName(csr, path[j]));
+            if (j < count - 1)
+                printf(" -> ");
+        }
+        printf("\n");
+    }
+
+    free(path);
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> HIERARCHIE DE CONTRACTION (REQUETES POINT A POINT)
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Colonne du CSR correspondant au critère
+const float *routeMetricColumn(const CSRGraph *csr, RouteMetric metric)
+{
+    switch (metric)
+    {
+    case METRIC_TIME:
+        return csr->baseTime;
+    case METRIC_COST:
+        return csr->cost;
+    default:
+        return csr->distance;
+    }
+}
+
+const char *routeMetricName(RouteMetric metric)
+{
+    switch (metric)
+    {
+    case METRIC_TIME:
+        return "temps";
+    case METRIC_COST:
+        return "coût";
+    default:
+        return "distance";
+    }
+}
+
+// Empreinte du graphe vue par la hiérarchie : toute modification d'une route ou de son
+// poids invalide une hiérarchie enregistrée
+static uint64_t chGraphHash(const CSRGraph *csr, RouteMetric metric)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = snapshotChecksum(hash, (const unsigned char *)&csr->V, sizeof(int));
+    hash = snapshotChecksum(hash, (const unsigned char *)csr->offsets, (csr->V + 1) * sizeof(int));
+    hash = snapshotChecksum(hash, (const unsigned char *)csr->dest, csr->E * sizeof(int));
+    hash = snapshotChecksum(hash, (const unsigned char *)routeMetricColumn(csr, metric), csr->E * sizeof(float));
+    return hash;
+}
+
+// Graphe modifiable utilisé pendant la contraction : listes d'arcs sortants et entrants
+typedef struct CHArc
+{
+    int node;
+    float weight;
+    int middle;
+} CHArc;
+
+typedef struct CHArcList
+{
+    CHArc *arcs;
+    int count;
+    int capacity;
+} CHArcList;
+
+typedef struct CHBuilder
+{
+    int V;
+    CHArcList *out;
+    CHArcList *in;
+    bool *contracted;
+    int *deletedNeighbors; // voisins déjà contractés (répartit la contraction dans le graphe)
+    float *dist;           // recherche de témoins
+    unsigned int *stamp;
+    unsigned int generation;
+    IndexedHeap *heap;
+} CHBuilder;
+
+static bool chArcAppend(CHArcList *list, int node, float weight, int middle)
+{
+    if (list->count == list->capacity)
+    {
+        int capacity = list->capacity ? list->capacity * 2 : 4;
+        CHArc *arcs = (CHArc *)realloc(list->arcs, capacity * sizeof(CHArc));
+        if (!arcs)
+            return false;
+        list->arcs = arcs;
+        list->capacity = capacity;
+    }
+    list->arcs[list->count].node = node;
+    list->arcs[list->count].weight = weight;
+    list->arcs[list->count].middle = middle;
+    list->count++;
+    return true;
+}
+
+static CHArc *chArcFind(CHArcList *list, int node)
+{
+    for (int i = 0; i < list->count; i++)
+    {
+        if (list->arcs[i].node == node)
+            return &list->arcs[i];
+    }
+    return NULL;
+}
+
+// Ajoute l'arc u -> w, ou abaisse son poids s'il existe déjà (un seul arc par couple)
+static bool chAddArc(CHBuilder *b, int u, int w, float weight, int middle)
+{
+    CHArc *out = chArcFind(&b->out[u], w);
+    if (out)
+    {
+        if (weight < out->weight)
+        {
+            CHArc *in = chArcFind(&b->in[w], u);
+            out->weight = in->weight = weight;
+            out->middle = in->middle = middle;
+        }
+        return true;
+    }
+    return chArcAppend(&b->out[u], w, weight, middle) && chArcAppend(&b->in[w], u, weight, middle);
+}
+
+// Dijkstra local depuis u dans le graphe restant, sans passer par v, borné par maxWeight
+// et par CH_WITNESS_LIMIT sommets fixés. Les distances trouvées sont des majorants valides.
+static void chWitnessSearch(CHBuilder *b, int u, int v, float maxWeight)
+{
+    if (++b->generation == 0)
+    {
+        memset(b->stamp, 0, b->V * sizeof(unsigned int));
+        b->generation = 1;
+    }
+    heapClear(b->heap);
+    b->stamp[u] = b->generation;
+    b->dist[u] = 0;
+    heapPushOrDecrease(b->heap, u, 0);
+
+    int settled = 0;
+    while (b->heap->size > 0 && b->heap->keys[0] <= maxWeight && settled < CH_WITNESS_LIMIT)
+    {
+        int x = heapPopMin(b->heap);
+        settled++;
+        for (int i = 0; i < b->out[x].count; i++)
+        {
+            const CHArc *arc = &b->out[x].arcs[i];
+            if (arc->node == v || b->contracted[arc->node])
+                continue;
+            float d = b->dist[x] + arc->weight;
+            if (b->stamp[arc->node] != b->generation || d < b->dist[arc->node])
+            {
+                b->stamp[arc->node] = b->generation;
+                b->dist[arc->node] = d;
+                heapPushOrDecrease(b->heap, arc->node, d);
+            }
+        }
+    }
+}
+
+// Contracte v : pour chaque couple u -> v -> w sans chemin témoin au moins aussi court,
+// ajoute le raccourci u -> w. En simulation, compte seulement les raccourcis nécessaires.
+// Retourne le nombre de raccourcis, -1 si la mémoire manque.
+static int chContractNode(CHBuilder *b, int v, bool simulate)
+{
+    float maxOut = 0;
+    for (int j = 0; j < b->out[v].count; j++)
+    {
+        if (!b->contracted[b->out[v].arcs[j].node] && b->out[v].arcs[j].weight > maxOut)
+            maxOut = b->out[v].arcs[j].weight;
+    }
+
+    int shortcuts = 0;
+    for (int i = 0; i < b->in[v].count; i++)
+    {
+        int u = b->in[v].arcs[i].node;
+        float wuv = b->in[v].arcs[i].weight;
+        if (b->contracted[u])
+            continue;
+
+        chWitnessSearch(b, u, v, wuv + maxOut);
+        for (int j = 0; j < b->out[v].count; j++)
+        {
+            int w = b->out[v].arcs[j].node;
+            if (w == u || b->contracted[w])
+                continue;
+            float weight = wuv + b->out[v].arcs[j].weight;
+            if (b->stamp[w] == b->generation && b->dist[w] <= weight)
+                continue; // un témoin évite v
+
+            shortcuts++;
+            if (!simulate && !chAddArc(b, u, w, weight, v))
+                return -1;
+        }
+    }
+    return shortcuts;
+}
+
+// Priorité de contraction : deux fois la différence d'arcs (raccourcis ajoutés - arcs
+// retirés) plus le nombre de voisins déjà contractés. Les petites priorités passent en premier.
+static float chPriority(CHBuilder *b, int v)
+{
+    int removed = 0;
+    for (int i = 0; i < b->in[v].count; i++)
+        removed += !b->contracted[b->in[v].arcs[i].node];
+    for (int i = 0; i < b->out[v].count; i++)
+        removed += !b->contracted[b->out[v].arcs[i].node];
+    return (float)(2 * (chContractNode(b, v, true) - removed) + b->deletedNeighbors[v]);
+}
+
+static void chFreeBuilder(CHBuilder *b)
+{
+    for (int v = 0; b->out && v < b->V; v++)
+        free(b->out[v].arcs);
+    for (int v = 0; b->in && v < b->V; v++)
+        free(b->in[v].arcs);
+    free(b->out);
+    free(b->in);
+    free(b->contracted);
+    free(b->deletedNeighbors);
+    free(b->dist);
+    free(b->stamp);
+    freeIndexedHeap(b->heap);
+}
+
+static CHGraph *chAllocate(int V, int upCount, int downCount)
+{
+    CHGraph *ch = (CHGraph *)calloc(1, sizeof(CHGraph));
+    if (!ch)
+        return NULL;
+    ch->V = V;
+    ch->rank = (int *)malloc(V * sizeof(int));
+    ch->upOffsets = (int *)malloc((V + 1) * sizeof(int));
+    ch->upTarget = (int *)malloc((upCount ? upCount : 1) * sizeof(int));
+    ch->upWeight = (float *)malloc((upCount ? upCount : 1) * sizeof(float));
+    ch->upMiddle = (int *)malloc((upCount ? upCount : 1) * sizeof(int));
+    ch->downOffsets = (int *)malloc((V + 1) * sizeof(int));
+    ch->downSource = (int *)malloc((downCount ? downCount : 1) * sizeof(int));
+    ch->downWeight = (float *)malloc((downCount ? downCount : 1) * sizeof(float));
+    ch->downMiddle = (int *)malloc((downCount ? downCount : 1) * sizeof(int));
+    if (!ch->rank || !ch->upOffsets || !ch->upTarget || !ch->upWeight || !ch->upMiddle || !ch->downOffsets ||
+        !ch->downSource || !ch->downWeight || !ch->downMiddle)
+    {
+        freeContractionHierarchy(ch);
+        return NULL;
+    }
+    return ch;
+}
+
+// Fonction pour construire la hiérarchie de contraction du graphe pour un critère donné.
+// Les sommets sont contractés un à un par priorité croissante (mise à jour paresseuse :
+// la priorité d'un sommet est recalculée quand il sort du tas). Les poids doivent être >= 0.
+CHGraph *buildContractionHierarchy(const CSRGraph *csr, RouteMetric metric)
+{
+    int V = csr->V;
+    const float *weight = routeMetricColumn(csr, metric);
+    for (int e = 0; e < csr->E; e++)
+    {
+        if (weight[e] < 0)
+        {
+            printf("Erreur : la hiérarchie de contraction exige des poids positifs.\n");
+            return NULL;
+        }
+    }
+
+    CHBuilder b;
+    memset(&b, 0, sizeof(b));
+    b.V = V;
+    b.out = (CHArcList *)calloc(V, sizeof(CHArcList));
+    b.in = (CHArcList *)calloc(V, sizeof(CHArcList));
+    b.contracted = (bool *)calloc(V, sizeof(bool));
+    b.deletedNeighbors = (int *)calloc(V, sizeof(int));
+    b.dist = (float *)malloc(V * sizeof(float));
+    b.stamp = (unsigned int *)calloc(V, sizeof(unsigned int));
+    b.heap = createIndexedHeap(V);
+    IndexedHeap *order = createIndexedHeap(V);
+    CHGraph *ch = NULL;
+    bool ok = b.out && b.in && b.contracted && b.deletedNeighbors && b.dist && b.stamp && b.heap && order;
+
+    // Graphe initial : un seul arc (le plus léger) par couple, sans boucle
+    for (int u = 0; ok && u < V; u++)
+    {
+        for (int e = csr->offsets[u]; ok && e < csr->offsets[u + 1]; e++)
+        {
+            if (csr->dest[e] != u)
+                ok = chAddArc(&b, u, csr->dest[e], weight[e], -1);
+        }
+    }
+
+    int *rank = (int *)malloc(V * sizeof(int));
+    ok = ok && rank;
+    for (int v = 0; ok && v < V; v++)
+        heapPushOrDecrease(order, v, chPriority(&b, v));
+
+    int next = 0;
+    while (ok && order->size > 0)
+    {
+        int v = heapPopMin(order);
+        float priority = chPriority(&b, v);
+        if (order->size > 0 && priority > order->keys[0])
+        {
+            heapPushOrDecrease(order, v, priority); // priorité périmée : on le repousse
+            continue;
+        }
+
+        ok = chContractNode(&b, v, false) >= 0;
+        b.contracted[v] = true;
+        rank[v] = next++;
+        for (int i = 0; i < b.out[v].count; i++)
+            b.deletedNeighbors[b.out[v].arcs[i].node]++;
+        for (int i = 0; i < b.in[v].count; i++)
+            b.deletedNeighbors[b.in[v].arcs[i].node]++;
+    }
+
+    // Figement en deux CSR : arcs montants rangés à la source, arcs descendants à la cible
+    int upCount = 0, downCount = 0;
+    for (int u = 0; ok && u < V; u++)
+    {
+        for (int i = 0; i < b.out[u].count; i++)
+            upCount += rank[b.out[u].arcs[i].node] > rank[u];
+        for (int i = 0; i < b.in[u].count; i++)
+            downCount += rank[b.in[u].arcs[i].node] > rank[u];
+    }
+    if (ok)
+        ch = chAllocate(V, upCount, downCount);
+    if (ch)
+    {
+        ch->metric = metric;
+        ch->graphHash = chGraphHash(csr, metric);
+        memcpy(ch->rank, rank, V * sizeof(int));
+        int up = 0, down = 0;
+        for (int u = 0; u < V; u++)
+        {
+            ch->upOffsets[u] = up;
+            for (int i = 0; i < b.out[u].count; i++)
+            {
+                const CHArc *arc = &b.out[u].arcs[i];
+                if (rank[arc->node] > rank[u])
+                {
+                    ch->upTarget[up] = arc->node;
+                    ch->upWeight[up] = arc->weight;
+                    ch->upMiddle[up] = arc->middle;
+                    ch->shortcuts += arc->middle >= 0;
+                    up++;
+                }
+            }
+            ch->downOffsets[u] = down;
+            for (int i = 0; i < b.in[u].count; i++)
+            {
+                const CHArc *arc = &b.in[u].arcs[i];
+                if (rank[arc->node] > rank[u])
+                {
+                    ch->downSource[down] = arc->node;
+                    ch->downWeight[down] = arc->weight;
+                    ch->downMiddle[down] = arc->middle;
+                    ch->shortcuts += arc->middle >= 0;
+                    down++;
+                }
+            }
+        }
+        ch->upOffsets[V] = up;
+        ch->downOffsets[V] = down;
+    }
+    else
+    {
+        printf("Erreur : allocation mémoire échouée pour la hiérarchie de contraction.\n");
+    }
+
+    free(rank);
+    freeIndexedHeap(order);
+    chFreeBuilder(&b);
+    return ch;
+}
+
+void freeContractionHierarchy(CHGraph *ch)
+{
+    if (!ch)
+        return;
+    free(ch->rank);
+    free(ch->upOffsets);
+    free(ch->upTarget);
+    free(ch->upWeight);
+    free(ch->upMiddle);
+    free(ch->downOffsets);
+    free(ch->downSource);
+    free(ch->downWeight);
+    free(ch->downMiddle);
+    free(ch);
+}
+
+// En-tête du fichier de hiérarchie (graph.ch), suivi des tableaux dans l'ordre de CHGraph
+typedef struct CHFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t metric;
+    uint64_t graphHash;
+    int32_t V;
+    int32_t upCount;
+    int32_t downCount;
+    int32_t shortcuts;
+} CHFileHeader;
+
+static void chSections(CHGraph *ch, int upCount, int downCount, void **fields, size_t *sizes)
+{
+    int V = ch->V;
+    void *f[] = {ch->rank, ch->upOffsets, ch->upTarget, ch->upWeight, ch->upMiddle,
+                 ch->downOffsets, ch->downSource, ch->downWeight, ch->downMiddle};
+    size_t s[] = {V * sizeof(int), (V + 1) * sizeof(int), upCount * sizeof(int), upCount * sizeof(float),
+                  upCount * sizeof(int), (V + 1) * sizeof(int), downCount * sizeof(int),
+                  downCount * sizeof(float), downCount * sizeof(int)};
+    memcpy(fields, f, sizeof(f));
+    memcpy(sizes, s, sizeof(s));
+}
+
+// Fonction pour enregistrer la hiérarchie (rechargée ensuite par loadContractionHierarchy)
+bool saveContractionHierarchy(const CHGraph *ch, const char *filename)
+{
+    CHFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CH_MAGIC, sizeof(header.magic));
+    header.version = CH_VERSION;
+    header.metric = (uint32_t)ch->metric;
+    header.graphHash = ch->graphHash;
+    header.V = ch->V;
+    header.upCount = ch->upOffsets[ch->V];
+    header.downCount = ch->downOffsets[ch->V];
+    header.shortcuts = ch->shortcuts;
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        printf("Erreur : impossible de créer le fichier %s\n", filename);
+        return false;
+    }
+
+    void *fields[9];
+    size_t sizes[9];
+    chSections((CHGraph *)ch, header.upCount, header.downCount, fields, sizes);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int s = 0; s < 9 && ok; s++)
+        ok = sizes[s] == 0 || fwrite(fields[s], 1, sizes[s], file) == sizes[s];
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        printf("Erreur : écriture de la hiérarchie %s incomplète.\n", filename);
+        remove(filename);
+    }
+    return ok;
+}
+
+// Fonction pour recharger une hiérarchie enregistrée. Retourne NULL (sans message) si le
+// fichier est absent, d'une autre version, d'un autre critère ou construit sur un autre graphe.
+CHGraph *loadContractionHierarchy(const char *filename, const CSRGraph *csr, RouteMetric metric)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+        return NULL;
+
+    CHFileHeader header;
+    CHGraph *ch = NULL;
+    if (fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, CH_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == CH_VERSION && header.metric == (uint32_t)metric && header.V == csr->V &&
+        header.upCount >= 0 && header.downCount >= 0 && header.graphHash == chGraphHash(csr, metric))
+    {
+        ch = chAllocate(header.V, header.upCount, header.downCount);
+    }
+
+    if (ch)
+    {
+        ch->metric = metric;
+        ch->graphHash = header.graphHash;
+        ch->shortcuts = header.shortcuts;
+        void *fields[9];
+        size_t sizes[9];
+        chSections(ch, header.upCount, header.downCount, fields, sizes);
+        bool ok = true;
+        for (int s = 0; s < 9 && ok; s++)
+            ok = sizes[s] == 0 || fread(fields[s], 1, sizes[s], file) == sizes[s];
+        ok = ok && ch->upOffsets[ch->V] == header.upCount && ch->downOffsets[ch->V] == header.downCount;
+        if (!ok)
+        {
+            printf("Erreur : hiérarchie %s tronquée, elle sera reconstruite.\n", filename);
+            freeContractionHierarchy(ch);
+            ch = NULL;
+        }
+    }
+
+    fclose(file);
+    return ch;
+}
+
+// Fonction pour obtenir la hiérarchie du graphe : rechargée depuis filename si elle
+// correspond encore au graphe, sinon reconstruite puis enregistrée pour le prochain lancement
+CHGraph *openContractionHierarchy(const CSRGraph *csr, RouteMetric metric, const char *filename)
+{
+    CHGraph *ch = loadContractionHierarchy(filename, csr, metric);
+    if (ch)
+        return ch;
+
+    ch = buildContractionHierarchy(csr, metric);
+    if (ch)
+        saveContractionHierarchy(ch, filename);
+    return ch;
+}
+
+CHQuery *createCHQuery(int V)
+{
+    CHQuery *query = (CHQuery *)calloc(1, sizeof(CHQuery));
+    if (!query)
+    {
+        printf("Erreur : allocation mémoire échouée pour la requête.\n");
+        return NULL;
+    }
+    bool ok = true;
+    for (int d = 0; d < 2; d++)
+    {
+        query->stamp[d] = (unsigned int *)calloc(V, sizeof(unsigned int));
+        query->dist[d] = (float *)malloc(V * sizeof(float));
+        query->pred[d] = (int *)malloc(V * sizeof(int));
+        query->heap[d] = createIndexedHeap(V);
+        ok = ok && query->stamp[d] && query->dist[d] && query->pred[d] && query->heap[d];
+    }
+    if (!ok)
+    {
+        printf("Erreur : allocation mémoire échouée pour la requête.\n");
+        freeCHQuery(query);
+        return NULL;
+    }
+    query->generation = 0;
+    return query;
+}
+
+void freeCHQuery(CHQuery *query)
+{
+    if (!query)
+        return;
+    for (int d = 0; d < 2; d++)
+    {
+        free(query->stamp[d]);
+        free(query->dist[d]);
+        free(query->pred[d]);
+        freeIndexedHeap(query->heap[d]);
+    }
+    free(query);
+}
+
+// Sommet contourné par l'arc a -> b de la hiérarchie (-1 pour une route réelle)
+static int chArcMiddle(const CHGraph *ch, int a, int b)
+{
+    if (ch->rank[b] > ch->rank[a])
+    {
+        for (int i = ch->upOffsets[a]; i < ch->upOffsets[a + 1]; i++)
+        {
+            if (ch->upTarget[i] == b)
+                return ch->upMiddle[i];
+        }
+    }
+    else
+    {
+        for (int i = ch->downOffsets[b]; i < ch->downOffsets[b + 1]; i++)
+        {
+            if (ch->downSource[i] == a)
+                return ch->downMiddle[i];
+        }
+    }
+    return -1;
+}
+
+// Déplie récursivement l'arc a -> b : ajoute à path les sommets qui suivent a, jusqu'à b
+static void chUnpackArc(const CHGraph *ch, int a, int b, int *path, int *count)
+{
+    int middle = chArcMiddle(ch, a, b);
+    if (middle < 0)
+    {
+        path[(*count)++] = b;
+        return;
+    }
+    chUnpackArc(ch, a, middle, path, count);
+    chUnpackArc(ch, middle, b, path, count);
+}
+
+// Fonction pour calculer le plus court chemin de s à t (critère de la hiérarchie) par deux
+// recherches de Dijkstra qui ne montent que vers des rangs supérieurs : avant depuis s sur
+// les arcs montants, arrière depuis t sur les arcs descendants. Si path est fourni (V cases),
+// il reçoit le chemin complet dans le graphe d'origine et *pathLength son nombre de sommets.
+// Retourne la longueur du chemin, ou INF si t est inaccessible depuis s.
+float chQuery(const CHGraph *ch, CHQuery *query, int s, int t, int *path, int *pathLength)
+{
+    if (++query->generation == 0)
+    {
+        memset(query->stamp[0], 0, ch->V * sizeof(unsigned int));
+        memset(query->stamp[1], 0, ch->V * sizeof(unsigned int));
+        query->generation = 1;
+    }
+    unsigned int gen = query->generation;
+    int ends[2] = {s, t};
+    for (int d = 0; d < 2; d++)
+    {
+        heapClear(query->heap[d]);
+        query->stamp[d][ends[d]] = gen;
+        query->dist[d][ends[d]] = 0;
+        query->pred[d][ends[d]] = -1;
+        heapPushOrDecrease(query->heap[d], ends[d], 0);
+    }
+
+    float best = INF;
+    int meet = -1;
+    query->settled = 0;
+    for (;;)
+    {
+        // Une recherche s'arrête dès que son minimum atteint la meilleure longueur connue
+        bool open[2];
+        for (int d = 0; d < 2; d++)
+            open[d] = query->heap[d]->size > 0 && query->heap[d]->keys[0] < best;
+        if (!open[0] && !open[1])
+            break;
+        int d = open[0] && (!open[1] || query->heap[0]->keys[0] <= query->heap[1]->keys[0]) ? 0 : 1;
+
+        int u = heapPopMin(query->heap[d]);
+        float du = query->dist[d][u];
+        query->settled++;
+        if (query->stamp[1 - d][u] == gen && du + query->dist[1 - d][u] < best)
+        {
+            best = du + query->dist[1 - d][u];
+            meet = u;
+        }
+
+        const int *offsets = d == 0 ? ch->upOffsets : ch->downOffsets;
+        const int *other = d == 0 ? ch->upTarget : ch->downSource;
+        const float *weight = d == 0 ? ch->upWeight : ch->downWeight;
+
+        // Arrêt à la demande : si un sommet de rang supérieur déjà atteint mène à u par un
+        // chemin plus court, dist[d][u] n'est pas optimale et u n'est pas développé
+        const int *stallOffsets = d == 0 ? ch->downOffsets : ch->upOffsets;
+        const int *stallOther = d == 0 ? ch->downSource : ch->upTarget;
+        const float *stallWeight = d == 0 ? ch->downWeight : ch->upWeight;
+        bool stalled = false;
+        for (int i = stallOffsets[u]; i < stallOffsets[u + 1] && !stalled; i++)
+        {
+            int x = stallOther[i];
+            stalled = query->stamp[d][x] == gen && query->dist[d][x] + stallWeight[i] < du;
+        }
+        if (stalled)
+            continue;
+
+        for (int i = offsets[u]; i < offsets[u + 1]; i++)
+        {
+            int v = other[i];
+            float dv = du + weight[i];
+            if (query->stamp[d][v] != gen || dv < query->dist[d][v])
+            {
+                query->stamp[d][v] = gen;
+                query->dist[d][v] = dv;
+                query->pred[d][v] = u;
+                heapPushOrDecrease(query->heap[d], v, dv);
+            }
+        }
+    }
+
+    if (pathLength)
+        *pathLength = 0;
+    if (meet < 0 || !path)
+        return best;
+
+    // Chaîne de la hiérarchie : s ... meet par pred[0], puis meet ... t par pred[1]
+    int count = 0;
+    for (int v = meet; v != -1; v = query->pred[0][v])
+        count++;
+    int hops = 0;
+    for (int v = meet; v != -1; v = query->pred[1][v])
+        hops++;
+    int *chain = (int *)malloc((count + hops) * sizeof(int));
+    if (!chain)
+    {
+        printf("Erreur : allocation mémoire échouée pour le chemin.\n");
+        return best;
+    }
+    int i = count;
+    for (int v = meet; v != -1; v = query->pred[0][v])
+        chain[--i] = v;
+    for (int v = query->pred[1][meet]; v != -1; v = query->pred[1][v])
+        chain[count++] = v;
+
+    // Dépliage des raccourcis
+    int length = 0;
+    path[length++] = chain[0];
+    for (int j = 0; j + 1 < count; j++)
+        chUnpackArc(ch, chain[j], chain[j + 1], path, &length);
+    *pathLength = length;
+    free(chain);
+    return best;
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> A* AVEC POINTS DE REPERE (ALT)
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Dijkstra complet depuis src sur un critère, dans le graphe direct (reverse == NULL) ou
+// inverse : dist[v * stride] reçoit la distance de src à v (de v à src si inverse)
+static void dijkstraMetric(const CSRGraph *csr, const ReverseCSR *reverse, const float *weight, int src, float *dist,
+                           int stride, IndexedHeap *heap)
+{
+    for (int v = 0; v < csr->V; v++)
+        dist[(size_t)v * stride] = INF;
+    heapClear(heap);
+    dist[(size_t)src * stride] = 0;
+    heapPushOrDecrease(heap, src, 0);
+
+    const int *offsets = reverse ? reverse->offsets : csr->offsets;
+    const int *other = reverse ? reverse->source : csr->dest;
+    int u;
+    while ((u = heapPopMin(heap)) >= 0)
+    {
+        float du = dist[(size_t)u * stride];
+        for (int i = offsets[u]; i < offsets[u + 1]; i++)
+        {
+            int v = other[i];
+            float dv = du + weight[reverse ? reverse->edge[i] : i];
+            if (dv < dist[(size_t)v * stride])
+            {
+                dist[(size_t)v * stride] = dv;
+                heapPushOrDecrease(heap, v, dv);
+            }
+        }
+    }
+}
+
+// Fonction pour choisir K repères et calculer leurs distances (2 Dijkstra par repère).
+// Sélection « le plus éloigné » : le premier repère est le sommet de plus grand degré
+// sortant, chaque suivant est le sommet dont la distance aller-retour au repère le plus
+// proche est maximale. Les sommets sans aller-retour possible (villes isolées, autre
+// composante) sont écartés : leurs bornes seraient inutiles. Les poids doivent être >= 0.
+LandmarkIndex *buildLandmarkIndex(const CSRGraph *csr, const ReverseCSR *reverse, RouteMetric metric, int K)
+{
+    int V = csr->V;
+    const float *weight = routeMetricColumn(csr, metric);
+    for (int e = 0; e < csr->E; e++)
+    {
+        if (weight[e] < 0)
+        {
+            printf("Erreur : les repères exigent des poids positifs.\n");
+            return NULL;
+        }
+    }
+    if (K > V)
+        K = V;
+
+    LandmarkIndex *alt = (LandmarkIndex *)calloc(1, sizeof(LandmarkIndex));
+    IndexedHeap *heap = createIndexedHeap(V);
+    float *proximite = (float *)malloc(V * sizeof(float)); // aller-retour au repère le plus proche
+    if (alt)
+    {
+        alt->V = V;
+        alt->K = K;
+        alt->metric = metric;
+        alt->landmarks = (int *)malloc((K ? K : 1) * sizeof(int));
+        alt->from = (float *)malloc(((size_t)V * K + 1) * sizeof(float));
+        alt->to = (float *)malloc(((size_t)V * K + 1) * sizeof(float));
+    }
+    if (!alt || !heap || !proximite || !alt->landmarks || !alt->from || !alt->to)
+    {
+        printf("Erreur : allocation mémoire échouée pour les repères.\n");
+        freeIndexedHeap(heap);
+        free(proximite);
+        freeLandmarkIndex(alt);
+        return NULL;
+    }
+
+    int landmark = 0;
+    for (int v = 0; v < V; v++)
+    {
+        proximite[v] = FLT_MAX;
+        if (csr->offsets[v + 1] - csr->offsets[v] > csr->offsets[landmark + 1] - csr->offsets[landmark])
+            landmark = v;
+    }
+    for (int i = 0; i < K; i++)
+    {
+        alt->landmarks[i] = landmark;
+        dijkstraMetric(csr, NULL, weight, landmark, alt->from + i, K, heap);
+        dijkstraMetric(csr, reverse, weight, landmark, alt->to + i, K, heap);
+
+        int next = -1;
+        for (int v = 0; v < V; v++)
+        {
+            float from = alt->from[(size_t)v * K + i], to = alt->to[(size_t)v * K + i];
+            if (from == INF || to == INF)
+                continue;
+            if (from + to < proximite[v])
+                proximite[v] = from + to;
+            if (next < 0 || proximite[v] > proximite[next])
+                next = v;
+        }
+        landmark = next >= 0 ? next : (landmark + 1) % V;
+    }
+
+    freeIndexedHeap(heap);
+    free(proximite);
+    return alt;
+}
+
+void freeLandmarkIndex(LandmarkIndex *alt)
+{
+    if (!alt)
+        return;
+    free(alt->landmarks);
+    free(alt->from);
+    free(alt->to);
+    free(alt);
+}
+
+AStarQuery *createAStarQuery(int V)
+{
+    AStarQuery *query = (AStarQuery *)calloc(1, sizeof(AStarQuery));
+    if (query)
+    {
+        query->stamp = (unsigned int *)calloc(V, sizeof(unsigned int));
+        query->g = (float *)malloc(V * sizeof(float));
+        query->pred = (int *)malloc(V * sizeof(int));
+        query->heap = createIndexedHeap(V);
+    }
+    if (!query || !query->stamp || !query->g || !query->pred || !query->heap)
+    {
+        printf("Erreur : allocation mémoire échouée pour la requête.\n");
+        freeAStarQuery(query);
+        return NULL;
+    }
+    return query;
+}
+
+void freeAStarQuery(AStarQuery *query)
+{
+    if (!query)
+        return;
+    free(query->stamp);
+    free(query->g);
+    free(query->pred);
+    freeIndexedHeap(query->heap);
+    free(query);
+}
+
+// Borne inférieure de la distance de v à t par inégalité triangulaire sur chaque repère L :
+// d(v,t) >= d(L,t) - d(L,v) et d(v,t) >= d(v,L) - d(t,L). Les termes inconnus sont ignorés.
+static float altLowerBound(const LandmarkIndex *alt, int v, int t)
+{
+    const float *fromV = alt->from + (size_t)v * alt->K, *fromT = alt->from + (size_t)t * alt->K;
+    const float *toV = alt->to + (size_t)v * alt->K, *toT = alt->to + (size_t)t * alt->K;
+    float bound = 0;
+    for (int i = 0; i < alt->K; i++)
+    {
+        if (fromT[i] != INF && fromV[i] != INF && fromT[i] - fromV[i] > bound)
+            bound = fromT[i] - fromV[i];
+        if (toV[i] != INF && toT[i] != INF && toV[i] - toT[i] > bound)
+            bound = toV[i] - toT[i];
+    }
+    return bound;
+}
+
+// Fonction pour calculer le plus court chemin de s à t sur un critère par A*, guidé par
+// les bornes des repères (alt == NULL : Dijkstra point à point, arrêté à t). Si path est
+// fourni (V cases), il reçoit le chemin de s à t et *pathLength son nombre de sommets.
+// Retourne la longueur du chemin, ou INF si t est inaccessible.
+float astarQuery(const CSRGraph *csr, const LandmarkIndex *alt, RouteMetric metric, AStarQuery *query, int s, int t,
+                 int *path, int *pathLength)
+{
+    if (++query->generation == 0)
+    {
+        memset(query->stamp, 0, csr->V * sizeof(unsigned int));
+        query->generation = 1;
+    }
+    unsigned int gen = query->generation;
+    const float *weight = routeMetricColumn(csr, metric);
+
+    heapClear(query->heap);
+    query->settled = 0;
+    query->stamp[s] = gen;
+    query->g[s] = 0;
+    query->pred[s] = -1;
+    heapPushOrDecrease(query->heap, s, alt ? altLowerBound(alt, s, t) : 0);
+
+    float result = INF;
+    int u;
+    while ((u = heapPopMin(query->heap)) >= 0)
+    {
+        query->settled++;
+        if (u == t)
+        {
+            result = query->g[t];
+            break;
+        }
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+        {
+            int v = csr->dest[e];
+            float gv = query->g[u] + weight[e];
+            if (query->stamp[v] != gen || gv < query->g[v])
+            {
+                query->stamp[v] = gen;
+                query->g[v] = gv;
+                query->pred[v] = u;
+                heapPushOrDecrease(query->heap, v, gv + (alt ? altLowerBound(alt, v, t) : 0));
+            }
+        }
+    }
+
+    if (pathLength)
+        *pathLength = 0;
+    if (result == INF || !path)
+        return result;
+
+    int count = 0;
+    for (int v = t; v != -1; v = query->pred[v])
+        path[count++] = v;
+    for (int i = 0, j = count - 1; i < j; i++, j--)
+    {
+        int tmp = path[i];
+        path[i] = path[j];
+        path[j] = tmp;
+    }
+    *pathLength = count;
+    return result;
+}
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> GLOUTONNE ALGORITHM
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// ---------- CARTE DES DISTANCES ----------
+bool initialiserCarte(Carte *carte, const CSRGraph *csr, RouteMetric metric)
+{
+    memset(carte, 0, sizeof(Carte));
+    carte->csr = csr;
+    carte->weight = routeMetricColumn(csr, metric);
+    carte->V = csr->V;
+    carte->rowOf = (int *)malloc((csr->V > 0 ? csr->V : 1) * sizeof(int));
+    carte->heap = createIndexedHeap(csr->V > 0 ? csr->V : 1);
+    if (!carte->rowOf || !carte->heap)
+    {
+        printf("Erreur : allocation mémoire échouée pour la carte des distances.\n");
+        libererCarte(carte);
+        return false;
+    }
+    for (int v = 0; v < csr->V; v++)
+        carte->rowOf[v] = -1;
+    return true;
+}
+
+void libererCarte(Carte *carte)
+{
+    free(carte->rowOf);
+    free(carte->rows);
+    freeIndexedHeap(carte->heap);
+    memset(carte, 0, sizeof(Carte));
+}
+
+// Distances depuis origine vers toutes les villes, calculées au premier appel puis
+// mémorisées. Le pointeur rendu reste valable jusqu'au prochain calcul d'une nouvelle
+// ligne (le tableau des lignes peut être réalloué). NULL si la mémoire manque.
+const float *carteLigne(Carte *carte, int origine)
+{
+    if (carte->rowOf[origine] < 0)
+    {
+        size_t V = carte->V;
+        if (carte->nbRows == carte->capacity)
+        {
+            int capacity = carte->capacity ? 2 * carte->capacity : 8;
+            float *rows = (float *)realloc(carte->rows, (size_t)capacity * V * sizeof(float));
+            if (!rows)
+            {
+                printf("Erreur : allocation mémoire échouée pour la carte des distances.\n");
+                return NULL;
+            }
+            carte->rows = rows;
+            carte->capacity = capacity;
+        }
+        dijkstraMetric(carte->csr, NULL, carte->weight, origine, carte->rows + (size_t)carte->nbRows * V, 1,
+                       carte->heap);
+        carte->rowOf[origine] = carte->nbRows++;
+    }
+    return carte->rows + (size_t)carte->rowOf[origine] * carte->V;
+}
+
+float carteDistance(Carte *carte, int origine, int destination)
+{
+    const float *ligne = carteLigne(carte, origine);
+    return ligne ? ligne[destination] : INF;
+}
+
+// ---------- ARENE ET CONTENEURS EN COLONNES ----------
+// Zone de size octets alignée sur ARENA_ALIGN ; un nouveau bloc est pris quand le bloc
+// courant est plein (au moins ARENA_BLOCK_SIZE, ou la taille demandée)
+void *arenaAlloc(Arena *arena, size_t size)
+{
+    ArenaBlock *block = arena->head;
+    size_t header = (sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (block)
+    {
+        uintptr_t base = (uintptr_t)block + header;
+        uintptr_t start = (base + block->used + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+        if (start + size <= base + block->size)
+        {
+            block->used = start + size - base;
+            return (void *)start;
+        }
+    }
+
+    size_t capacity = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+    block = (ArenaBlock *)malloc(header + capacity + ARENA_ALIGN);
+    if (!block)
+        return NULL;
+    block->size = capacity + ARENA_ALIGN;
+    block->next = arena->head;
+    arena->head = block;
+    arena->bytes += header + block->size;
+    uintptr_t base = (uintptr_t)block + header;
+    uintptr_t start = (base + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+    block->used = start + size - base;
+    return (void *)start;
+}
+
+void arenaRelease(Arena *arena)
+{
+    while (arena->head)
+    {
+        ArenaBlock *next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    arena->bytes = 0;
+}
+
+// Nouvelle colonne de capacity éléments reprenant les count premiers de l'ancienne ;
+// l'ancienne zone reste dans l'arène (au pire le double de la taille finale, en doublant)
+static void *arenaGrow(Arena *arena, const void *old, size_t elemSize, int count, int capacity)
+{
+    void *column = arenaAlloc(arena, (size_t)capacity * elemSize);
+    if (column && count > 0)
+        memcpy(column, old, (size_t)count * elemSize);
+    return column;
+}
+
+// Capacité suivante d'un conteneur : doublement, 64 éléments au départ
+static int capaciteSuivante(int capacity, int needed)
+{
+    int n = capacity > 0 ? capacity * 2 : 64;
+    return n > needed ? n : needed;
+}
+
+void initialiserLotColis(LotColis *lot)
+{
+    memset(lot, 0, sizeof(LotColis));
+}
+
+void libererLotColis(LotColis *lot)
+{
+    arenaRelease(&lot->arena);
+    initialiserLotColis(lot);
+}
+
+// Charge du colis i, une valeur par dimension
+static inline void chargeDuColis(const LotColis *lot, int i, float *charge)
+{
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        charge[d] = lot->charge[d][i];
+}
+
+// Ajoute un colis (charge : une valeur par dimension) ; retourne son numéro, ou -1 si la
+// mémoire manque
+int ajouterColis(LotColis *lot, int villeDest, const float *charge, int urgent)
+{
+    if (lot->count == lot->capacity)
+    {
+        Arena *arena = &lot->arena;
+        int c = lot->count, n = capaciteSuivante(lot->capacity, c + 1);
+        int *dest = (int *)arenaGrow(arena, lot->villeDest, sizeof(int), c, n);
+        int *urg = (int *)arenaGrow(arena, lot->urgent, sizeof(int), c, n);
+        bool ok = dest && urg;
+        for (int d = 0; d < CAPACITE_DIMENSIONS && ok; d++)
+        {
+            float *colonne = (float *)arenaGrow(arena, lot->charge[d], sizeof(float), c, n);
+            ok = colonne != NULL;
+            if (ok)
+                lot->charge[d] = colonne;
+        }
+        if (!ok)
+        {
+            printf("Erreur : allocation mémoire échouée pour les colis.\n");
+            return -1;
+        }
+        lot->villeDest = dest;
+        lot->urgent = urg;
+        lot->capacity = n;
+    }
+    int i = lot->count++;
+    lot->villeDest[i] = villeDest;
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        lot->charge[d][i] = charge[d];
+    lot->urgent[i] = urgent;
+    return i;
+}
+
+void initialiserFlotte(Flotte *flotte)
+{
+    memset(flotte, 0, sizeof(Flotte));
+}
+
+void libererFlotte(Flotte *flotte)
+{
+    arenaRelease(&flotte->arena);
+    initialiserFlotte(flotte);
+}
+
+// Ajoute un véhicule à vide (capaciteMax : une valeur par dimension) ; retourne son
+// numéro, ou -1 si la mémoire manque
+int ajouterVehicule(Flotte *flotte, const float *capaciteMax, int villeActuelle)
+{
+    if (flotte->count == flotte->capacity)
+    {
+        Arena *arena = &flotte->arena;
+        int c = flotte->count, n = capaciteSuivante(flotte->capacity, c + 1);
+        int *ville = (int *)arenaGrow(arena, flotte->villeActuelle, sizeof(int), c, n);
+        int *nb = (int *)arenaGrow(arena, flotte->nbLivraisons, sizeof(int), c, n);
+        int *premiere = (int *)arenaGrow(arena, flotte->premiereLivraison, sizeof(int), c, n);
+        int *derniere = (int *)arenaGrow(arena, flotte->derniereLivraison, sizeof(int), c, n);
+        bool ok = ville && nb && premiere && derniere;
+        for (int d = 0; d < CAPACITE_DIMENSIONS && ok; d++)
+        {
+            float *maxi = (float *)arenaGrow(arena, flotte->capaciteMax[d], sizeof(float), c, n);
+            float *restante = (float *)arenaGrow(arena, flotte->capaciteRestante[d], sizeof(float), c, n);
+            ok = maxi && restante;
+            if (ok)
+            {
+                flotte->capaciteMax[d] = maxi;
+                flotte->capaciteRestante[d] = restante;
+            }
+        }
+        if (!ok)
+        {
+            printf("Erreur : allocation mémoire échouée pour la flotte.\n");
+            return -1;
+        }
+        flotte->villeActuelle = ville;
+        flotte->nbLivraisons = nb;
+        flotte->premiereLivraison = premiere;
+        flotte->derniereLivraison = derniere;
+        flotte->capacity = n;
+    }
+    int j = flotte->count++;
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        flotte->capaciteMax[d][j] = flotte->capaciteRestante[d][j] = capaciteMax[d];
+    flotte->villeActuelle[j] = villeActuelle;
+    flotte->nbLivraisons[j] = 0;
+    flotte->premiereLivraison[j] = flotte->derniereLivraison[j] = -1;
+    return j;
+}
+
+// Ajoute une ville à la fin de la tournée d'un véhicule ; false si la mémoire manque
+bool ajouterLivraison(Flotte *flotte, int vehicule, int ville)
+{
+    if (flotte->nbLivraisonsTotal == flotte->capaciteLivraisons)
+    {
+        int c = flotte->nbLivraisonsTotal, n = capaciteSuivante(flotte->capaciteLivraisons, c + 1);
+        int *villes = (int *)arenaGrow(&flotte->arena, flotte->livraisonVille, sizeof(int), c, n);
+        int *suivantes = (int *)arenaGrow(&flotte->arena, flotte->livraisonSuivante, sizeof(int), c, n);
+        if (!villes || !suivantes)
+        {
+            printf("Erreur : allocation mémoire échouée pour les tournées.\n");
+            return false;
+        }
+        flotte->livraisonVille = villes;
+        flotte->livraisonSuivante = suivantes;
+        flotte->capaciteLivraisons = n;
+    }
+    int l = flotte->nbLivraisonsTotal++;
+    flotte->livraisonVille[l] = ville;
+    flotte->livraisonSuivante[l] = -1;
+    if (flotte->derniereLivraison[vehicule] >= 0)
+        flotte->livraisonSuivante[flotte->derniereLivraison[vehicule]] = l;
+    else
+        flotte->premiereLivraison[vehicule] = l;
+    flotte->derniereLivraison[vehicule] = l;
+    flotte->nbLivraisons[vehicule]++;
+    return true;
+}
+
+// Remet la flotte à vide (capacités pleines, tournées effacées), sans rendre la mémoire
+void viderTournees(Flotte *flotte)
+{
+    for (int d = 0; d < CAPACITE_DIMENSIONS && flotte->count > 0; d++)
+        memcpy(flotte->capaciteRestante[d], flotte->capaciteMax[d], flotte->count * sizeof(float));
+    for (int j = 0; j < flotte->count; j++)
+    {
+        flotte->nbLivraisons[j] = 0;
+        flotte->premiereLivraison[j] = flotte->derniereLivraison[j] = -1;
+    }
+    flotte->nbLivraisonsTotal = 0;
+}
+
+// ---------- FILE DE PRIORITE DES COLIS ----------
+#define FILE_COLIS_CLASSE_BITS 8 // classes 0 (la plus prioritaire) à 255
+void initialiserFileColis(FileColis *file)
+{
+    memset(file, 0, sizeof(FileColis));
+}
+
+void libererFileColis(FileColis *file)
+{
+    free(file->keys);
+    memset(file, 0, sizeof(FileColis));
+}
+
+// Classe de priorité d'un colis (0 : traité en premier) : les urgents, puis les autres.
+// Une priorité par échéance n'aura qu'à découper ces classes plus finement.
+int classeColis(const LotColis *lot, int colis)
+{
+    return lot->urgent[colis] ? 0 : 1;
+}
+
+// Clé d'un colis dans la file : classe dans les bits de poids fort, numéro dans les 32 bits bas
+static inline uint64_t fileColisCle(const LotColis *lot, int colis)
+{
+    return (uint64_t)classeColis(lot, colis) << (64 - FILE_COLIS_CLASSE_BITS) | (uint32_t)colis;
+}
+
+// Insère un colis du lot ; false si la mémoire manque
+bool fileColisAjouter(FileColis *file, const LotColis *lot, int colis)
+{
+    if (file->size == file->capacity)
+    {
+        int n = capaciteSuivante(file->capacity, file->size + 1);
+        uint64_t *keys = (uint64_t *)realloc(file->keys, (size_t)n * sizeof(uint64_t));
+        if (!keys)
+        {
+            printf("Erreur : allocation mémoire échouée pour la file des colis.\n");
+            return false;
+        }
+        file->keys = keys;
+        file->capacity = n;
+    }
+    uint64_t key = fileColisCle(lot, colis);
+    int i = file->size++;
+    while (i > 0)
+    {
+        int parent = (i - 1) / HEAP_ARITY;
+        if (file->keys[parent] <= key)
+            break;
+        file->keys[i] = file->keys[parent];
+        i = parent;
+    }
+    file->keys[i] = key;
+    return true;
+}
+
+// Retire et retourne le colis le plus prioritaire (-1 si la file est vide)
+int fileColisExtraire(FileColis *file)
+{
+    if (file->size == 0)
+        return -1;
+    int top = (int)(uint32_t)file->keys[0];
+    uint64_t key = file->keys[--file->size];
+    int i = 0;
+    for (;;)
+    {
+        int first = i * HEAP_ARITY + 1;
+        if (first >= file->size)
+            break;
+        int last = first + HEAP_ARITY < file->size ? first + HEAP_ARITY : file->size;
+        int best = first;
+        for (int c = first + 1; c < last; c++)
+            if (file->keys[c] < file->keys[best])
+                best = c;
+        if (file->keys[best] >= key)
+            break;
+        file->keys[i] = file->keys[best];
+        i = best;
+    }
+    if (file->size > 0)
+        file->keys[i] = key;
+    return top;
+}
+
+// ---------- CAPACITES DE LA FLOTTE ----------
+// Véhicules où un colis tient dans toutes les dimensions, par comparaison colonne par
+// colonne sans branchement ; leurs numéros sont écrits dans liste (par ordre croissant)
+static int vehiculesCompatiblesScalaire(const Flotte *flotte, const float *charge, int *liste)
+{
+    int n = 0;
+    for (int j = 0; j < flotte->count; j++)
+    {
+        int ok = 1;
+        for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+            ok &= flotte->capaciteRestante[d][j] >= charge[d];
+        liste[n] = j;
+        n += ok;
+    }
+    return n;
+}
+
+#ifdef FW_SIMD_X86
+__attribute__((target("avx2"))) static int vehiculesCompatiblesAVX2(const Flotte *flotte, const float *charge, int *liste)
+{
+    __m256 vcharge[CAPACITE_DIMENSIONS];
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        vcharge[d] = _mm256_set1_ps(charge[d]);
+    int n = 0, j = 0;
+    for (; j + 8 <= flotte->count; j += 8)
+    {
+        __m256 ok = _mm256_cmp_ps(_mm256_loadu_ps(flotte->capaciteRestante[0] + j), vcharge[0], _CMP_GE_OQ);
+        for (int d = 1; d < CAPACITE_DIMENSIONS; d++)
+            ok = _mm256_and_ps(ok, _mm256_cmp_ps(_mm256_loadu_ps(flotte->capaciteRestante[d] + j), vcharge[d], _CMP_GE_OQ));
+        unsigned int masque = (unsigned int)_mm256_movemask_ps(ok);
+        while (masque)
+        {
+            liste[n++] = j + __builtin_ctz(masque);
+            masque &= masque - 1;
+        }
+    }
+    for (; j < flotte->count; j++)
+    {
+        int ok = 1;
+        for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+            ok &= flotte->capaciteRestante[d][j] >= charge[d];
+        liste[n] = j;
+        n += ok;
+    }
+    return n;
+}
+#endif
+
+// Retourne le nombre de véhicules compatibles (liste : flotte->count entiers au moins) ;
+// kernel : noyau résolu par floydWarshallResolveKernel (AVX2, sinon C portable)
+int vehiculesCompatibles(const Flotte *flotte, const float *charge, int *liste, FWKernel kernel)
+{
+#ifdef FW_SIMD_X86
+    if (kernel == FW_KERNEL_AVX2)
+        return vehiculesCompatiblesAVX2(flotte, charge, liste);
+#endif
+    (void)kernel;
+    return vehiculesCompatiblesScalaire(flotte, charge, liste);
+}
+
+// Score de remplissage multidimensionnel (à minimiser). Pour un véhicule entamé : somme sur
+// les dimensions du carré de la part de la capacité qui resterait libre une fois le colis
+// chargé (au plus CAPACITE_DIMENSIONS), le colis va dans celui qu'il remplit le mieux, toutes
+// dimensions comptées. Un véhicule vide ne vient qu'après tous les véhicules entamés, et le
+// plus grand d'abord (carré de la part que prend le colis) : il recevra le plus de colis
+// avant qu'il faille en ouvrir un autre.
+float resteApresCharge(const Flotte *flotte, int vehicule, const float *charge)
+{
+    float libre = 0.0f, pris = 0.0f;
+    bool vide = true;
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+    {
+        float maxi = flotte->capaciteMax[d][vehicule];
+        float restante = flotte->capaciteRestante[d][vehicule];
+        vide &= restante == maxi;
+        if (maxi > 0)
+        {
+            float l = (restante - charge[d]) / maxi, p = charge[d] / maxi;
+            libre += l * l;
+            pris += p * p;
+        }
+    }
+    return vide ? CAPACITE_DIMENSIONS + pris : libre;
+}
+
+// ---------- INDEX DES VEHICULES ----------
+// Ordre des clés d'un arbre : poids restant, puis numéro du véhicule (clés distinctes)
+static inline bool vehicleKeyLess(const VehicleIndex *index, int a, int b)
+{
+    const float *key = index->key[DIM_POIDS];
+    return key[a] < key[b] || (key[a] == key[b] && a < b);
+}
+
+// Le colis tient dans le véhicule j, ou dans au moins un véhicule de chaque dimension du
+// sous-arbre de racine j (condition nécessaire pour qu'un véhicule du sous-arbre convienne)
+static inline bool vehicleFits(const VehicleIndex *index, int j, const float *charge)
+{
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        if (index->key[d][j] < charge[d])
+            return false;
+    return true;
+}
+
+static inline bool subtreeMayFit(const VehicleIndex *index, int t, const float *charge)
+{
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        if (index->subMax[d][t] < charge[d])
+            return false;
+    return true;
+}
+
+// Recalcule les maxima du sous-arbre de t à partir de ses fils
+static inline void treapPull(VehicleIndex *index, int t)
+{
+    int l = index->left[t], r = index->right[t];
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+    {
+        float m = index->key[d][t];
+        if (l >= 0 && index->subMax[d][l] > m)
+            m = index->subMax[d][l];
+        if (r >= 0 && index->subMax[d][r] > m)
+            m = index->subMax[d][r];
+        index->subMax[d][t] = m;
+    }
+}
+
+// Coupe l'arbre t en deux autour de la clé de j : clés inférieures, clés supérieures
+static void treapSplit(VehicleIndex *index, int t, int j, int *less, int *greater)
+{
+    if (t < 0)
+    {
+        *less = *greater = -1;
+        return;
+    }
+    if (vehicleKeyLess(index, t, j))
+    {
+        treapSplit(index, index->right[t], j, &index->right[t], greater);
+        *less = t;
+    }
+    else
+    {
+        treapSplit(index, index->left[t], j, less, &index->left[t]);
+        *greater = t;
+    }
+    treapPull(index, t);
+}
+
+// Insère le véhicule j dans l'arbre t (descente jusqu'à la place de j selon sa priorité)
+static int treapInsert(VehicleIndex *index, int t, int j)
+{
+    if (t < 0 || index->priority[j] > index->priority[t])
+    {
+        // j devient la racine du sous-arbre : t est coupé en deux autour de la clé de j
+        treapSplit(index, t, j, &index->left[j], &index->right[j]);
+        treapPull(index, j);
+        return j;
+    }
+    if (vehicleKeyLess(index, j, t))
+        index->left[t] = treapInsert(index, index->left[t], j);
+    else
+        index->right[t] = treapInsert(index, index->right[t], j);
+    treapPull(index, t);
+    return t;
+}
+
+static int treapMerge(VehicleIndex *index, int a, int b)
+{
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    if (index->priority[a] > index->priority[b])
+    {
+        index->right[a] = treapMerge(index, index->right[a], b);
+        treapPull(index, a);
+        return a;
+    }
+    index->left[b] = treapMerge(index, a, index->left[b]);
+    treapPull(index, b);
+    return b;
+}
+
+static int treapErase(VehicleIndex *index, int t, int j)
+{
+    if (t == j)
+        return treapMerge(index, index->left[j], index->right[j]);
+    if (vehicleKeyLess(index, j, t))
+        index->left[t] = treapErase(index, index->left[t], j);
+    else
+        index->right[t] = treapErase(index, index->right[t], j);
+    treapPull(index, t);
+    return t;
+}
+
+// Véhicule de plus petit poids restant où le colis tient dans toutes les dimensions (-1 si
+// aucun) : parcours dans l'ordre des clés à partir du poids du colis, sans descendre dans
+// les sous-arbres dont un maximum est trop petit
+static int treapFirstFit(const VehicleIndex *index, int t, const float *charge)
+{
+    if (t < 0 || !subtreeMayFit(index, t, charge))
+        return -1;
+    if (index->key[DIM_POIDS][t] >= charge[DIM_POIDS])
+    {
+        int j = treapFirstFit(index, index->left[t], charge);
+        if (j >= 0)
+            return j;
+        if (vehicleFits(index, t, charge))
+            return t;
+    }
+    return treapFirstFit(index, index->right[t], charge);
+}
+
+// Véhicule compatible de plus petit resteApresCharge (égalité : plus petit numéro)
+static void treapBestFilled(const VehicleIndex *index, int t, const float *charge, int *best, float *score)
+{
+    if (t < 0 || !subtreeMayFit(index, t, charge))
+        return;
+    if (index->key[DIM_POIDS][t] >= charge[DIM_POIDS])
+    {
+        treapBestFilled(index, index->left[t], charge, best, score);
+        if (vehicleFits(index, t, charge))
+        {
+            float a = resteApresCharge(index->flotte, t, charge);
+            if (*best < 0 || a < *score || (a == *score && t < *best))
+            {
+                *best = t;
+                *score = a;
+            }
+        }
+    }
+    treapBestFilled(index, index->right[t], charge, best, score);
+}
+
+// Meilleur véhicule d'une ville selon le mode (-1 si le colis ne tient dans aucun)
+static int cityBestVehicle(const VehicleIndex *index, int c, const float *charge)
+{
+    int t = index->root[c];
+    if (t < 0 || !subtreeMayFit(index, t, charge))
+        return -1;
+    if (index->mode == AFFECTATION_PROCHE)
+        return treapFirstFit(index, t, charge);
+    int best = -1;
+    float score = 0.0f;
+    treapBestFilled(index, t, charge, &best, &score);
+    return best;
+}
+
+// Une ville est utile tant qu'elle peut encore recevoir le plus petit colis dans chaque
+// dimension (pas forcément dans le même véhicule)
+static inline bool cityUseful(const VehicleIndex *index, int c)
+{
+    return index->root[c] >= 0 && subtreeMayFit(index, index->root[c], index->chargeMin);
+}
+
+void freeVehicleIndex(VehicleIndex *index)
+{
+    if (!index)
+        return;
+    if (index->candidates)
+        for (int d = 0; d < index->V; d++)
+            free(index->candidates[d]);
+    free(index->candidates);
+    free(index->root);
+    free(index->left);
+    free(index->right);
+    free(index->priority);
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+    {
+        free(index->key[d]);
+        free(index->subMax[d]);
+    }
+    free(index->city);
+    free(index->cities);
+    free(index);
+}
+
+VehicleIndex *createVehicleIndex(const Flotte *flotte, int V, const float *chargeMin, ModeAffectation mode)
+{
+    int nbVehicules = flotte->count;
+    VehicleIndex *index = (VehicleIndex *)calloc(1, sizeof(VehicleIndex));
+    int n = nbVehicules > 0 ? nbVehicules : 1;
+    bool ok = index != NULL;
+    if (index)
+    {
+        index->flotte = flotte;
+        index->mode = mode;
+        index->nbVehicules = nbVehicules;
+        index->V = V;
+        index->root = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+        index->left = (int *)malloc(n * sizeof(int));
+        index->right = (int *)malloc(n * sizeof(int));
+        index->priority = (unsigned int *)malloc(n * sizeof(unsigned int));
+        index->city = (int *)malloc(n * sizeof(int));
+        index->cities = (int *)malloc(n * sizeof(int));
+        index->candidates = (CityCandidates **)calloc(V > 0 ? V : 1, sizeof(CityCandidates *));
+        ok = index->root && index->left && index->right && index->priority && index->city && index->cities &&
+             index->candidates;
+        for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        {
+            index->chargeMin[d] = chargeMin[d];
+            index->key[d] = (float *)malloc(n * sizeof(float));
+            index->subMax[d] = (float *)malloc(n * sizeof(float));
+            ok = ok && index->key[d] && index->subMax[d];
+        }
+    }
+    if (!ok)
+    {
+        printf("Erreur : allocation mémoire échouée pour l'index des véhicules.\n");
+        freeVehicleIndex(index);
+        return NULL;
+    }
+
+    for (int c = 0; c < V; c++)
+        index->root[c] = -1;
+    unsigned int etat = 2654435761u;
+    for (int j = 0; j < nbVehicules; j++)
+    {
+        etat ^= etat << 13;
+        etat ^= etat >> 17;
+        etat ^= etat << 5;
+        int c = flotte->villeActuelle[j];
+        index->priority[j] = etat;
+        index->city[j] = c;
+        for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+            index->key[d][j] = flotte->capaciteRestante[d][j];
+        index->left[j] = index->right[j] = -1;
+        if (index->root[c] < 0)
+            index->cities[index->nbCities++] = c;
+        index->root[c] = treapInsert(index, index->root[c], j);
+    }
+    return index;
+}
+
+// Reprend les capacités restantes d'un véhicule dans la flotte après un chargement
+void vehicleIndexUpdate(VehicleIndex *index, int vehicule)
+{
+    int c = index->city[vehicule];
+    index->root[c] = treapErase(index, index->root[c], vehicule);
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+        index->key[d][vehicule] = index->flotte->capaciteRestante[d][vehicule];
+    index->left[vehicule] = index->right[vehicule] = -1;
+    index->root[c] = treapInsert(index, index->root[c], vehicule);
+}
+
+// Les VEHICLE_INDEX_CANDIDATES villes occupées les plus proches de destination, parmi
+// celles qui peuvent encore recevoir le plus petit colis (tri par insertion, O(villes))
+static void buildCityCandidates(VehicleIndex *index, Carte *carte, int destination, CityCandidates *list)
+{
+    list->count = 0;
+    list->complete = true;
+    for (int k = 0; k < index->nbCities; k++)
+    {
+        int c = index->cities[k];
+        float d = carteDistance(carte, c, destination);
+        if (d >= INF || !cityUseful(index, c))
+            continue;
+        if (list->count == VEHICLE_INDEX_CANDIDATES)
+        {
+            list->complete = false;
+            int last = list->count - 1;
+            if (d > list->distance[last] || (d == list->distance[last] && c > list->city[last]))
+                continue;
+            list->count--;
+        }
+        int i = list->count++;
+        while (i > 0 && (list->distance[i - 1] > d || (list->distance[i - 1] == d && list->city[i - 1] > c)))
+        {
+            list->city[i] = list->city[i - 1];
+            list->distance[i] = list->distance[i - 1];
+            i--;
+        }
+        list->city[i] = c;
+        list->distance[i] = d;
+    }
+}
+
+// Meilleur véhicule pour un colis : le plus proche de la destination parmi ceux où il tient
+// dans toutes les dimensions, et dans sa ville le meilleur selon le mode. Les villes
+// candidates mémorisées sont parcourues dans l'ordre ; une ville devenue inutile (plus
+// aucun véhicule pour le plus petit colis) en est retirée. Si aucune ne convient et que
+// la liste n'est pas complète, toutes les villes occupées sont examinées. Les capacités
+// ne font que baisser : un colis au moins aussi gros, dans chaque dimension, qu'une charge
+// déjà refusée faute de capacité est refusé sans recherche.
+// Retourne le véhicule, ou AFFECTATION_CAPACITE / AFFECTATION_INACCESSIBLE.
+int vehicleIndexBest(VehicleIndex *index, Carte *carte, int destination, const float *charge, float *distance)
+{
+    for (int e = 0; e < index->nbEchecs; e++)
+    {
+        int d = 0;
+        while (d < CAPACITE_DIMENSIONS && charge[d] >= index->echecs[e][d])
+            d++;
+        if (d == CAPACITE_DIMENSIONS)
+            return AFFECTATION_CAPACITE;
+    }
+
+    CityCandidates *list = index->candidates[destination];
+    if (!list)
+    {
+        list = index->candidates[destination] = (CityCandidates *)malloc(sizeof(CityCandidates));
+        if (!list)
+        {
+            printf("Erreur : allocation mémoire échouée pour l'index des véhicules.\n");
+            return AFFECTATION_CAPACITE;
+        }
+        buildCityCandidates(index, carte, destination, list);
+    }
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int kept = 0;
+        int best = -1;
+        for (int i = 0; i < list->count; i++)
+        {
+            int c = list->city[i];
+            if (best < 0)
+            {
+                int j = cityBestVehicle(index, c, charge);
+                if (j >= 0)
+                {
+                    best = j;
+                    *distance = list->distance[i];
+                }
+            }
+            if (cityUseful(index, c))
+            {
+                list->city[kept] = c;
+                list->distance[kept++] = list->distance[i];
+            }
+        }
+        list->count = kept;
+        if (best >= 0)
+            return best;
+        if (list->complete || kept > 0)
+            break;
+        buildCityCandidates(index, carte, destination, list); // liste épuisée : on la reconstruit
+    }
+
+    // Au-delà des villes mémorisées : recherche sur toutes les villes occupées
+    int best = -1;
+    bool capacite = false;
+    float bestDistance = INF;
+    for (int k = 0; k < index->nbCities; k++)
+    {
+        int c = index->cities[k];
+        int j = cityBestVehicle(index, c, charge);
+        if (j < 0)
+            continue;
+        capacite = true;
+        float d = carteDistance(carte, c, destination);
+        if (!list->complete && d < INF && (d < bestDistance || (d == bestDistance && c < index->city[best])))
+        {
+            best = j;
+            bestDistance = d;
+        }
+    }
+    if (best >= 0)
+    {
+        *distance = bestDistance;
+        return best;
+    }
+    if (capacite)
+        return AFFECTATION_INACCESSIBLE;
+
+    // Seules les charges refusées minimales sont gardées : celles qui contiennent ce colis
+    // dans toutes les dimensions deviennent inutiles
+    int kept = 0;
+    for (int e = 0; e < index->nbEchecs; e++)
+    {
+        int d = 0;
+        while (d < CAPACITE_DIMENSIONS && index->echecs[e][d] >= charge[d])
+            d++;
+        if (d < CAPACITE_DIMENSIONS)
+            memcpy(index->echecs[kept++], index->echecs[e], sizeof(index->echecs[0]));
+    }
+    index->nbEchecs = kept;
+    if (index->nbEchecs < VEHICLE_INDEX_ECHECS)
+        memcpy(index->echecs[index->nbEchecs++], charge, sizeof(index->echecs[0]));
+    return AFFECTATION_CAPACITE;
+}
+
+// ---------- AFFECTATION GLOUTONNE ----------
+// Même choix que vehicleIndexBest par parcours complet de la flotte : les véhicules où le
+// colis tient sont filtrés colonne par colonne (noyau SIMD), puis départagés par distance,
+// ville, critère du mode et numéro. liste : flotte->count entiers de travail.
+// Retourne le véhicule, ou AFFECTATION_CAPACITE / AFFECTATION_INACCESSIBLE.
+int meilleurVehiculeParcours(const Flotte *flotte, Carte *carte, int destination, const float *charge,
+                             ModeAffectation mode, FWKernel kernel, int *liste, float *distance)
+{
+    int n = vehiculesCompatibles(flotte, charge, liste, kernel);
+    int best = -1;
+    float bestDistance = INF, bestCritere = 0.0f;
+    for (int k = 0; k < n; k++)
+    {
+        int j = liste[k];
+        float d = carteDistance(carte, flotte->villeActuelle[j], destination);
+        if (d >= INF || d > bestDistance)
+            continue;
+        // Critère à minimiser dans la ville : poids restant, ou place libre après chargement
+        float critere = mode == AFFECTATION_PROCHE ? flotte->capaciteRestante[DIM_POIDS][j]
+                                                   : resteApresCharge(flotte, j, charge);
+        if (best < 0 || d < bestDistance || flotte->villeActuelle[j] < flotte->villeActuelle[best] ||
+            (flotte->villeActuelle[j] == flotte->villeActuelle[best] && critere < bestCritere))
+        {
+            best = j;
+            bestDistance = d;
+            bestCritere = critere;
+        }
+    }
+    if (best >= 0)
+    {
+        *distance = bestDistance;
+        return best;
+    }
+    return n > 0 ? AFFECTATION_INACCESSIBLE : AFFECTATION_CAPACITE;
+}
+
+// Affecte les n colis de ordre (NULL : tous, par numéro), chacun au meilleur véhicule où il
+// tient en poids et en volume (index par ville et par capacités, voir vehicleIndexBest) ;
+// un véhicule qui ne peut pas rejoindre la destination est ignoré.
+static int affecterColisDansOrdre(Flotte *flotte, const LotColis *colis, const int *ordre, int n,
+                                  ModeAffectation mode, Carte *carte, int *affectation, float *distance)
+{
+    float chargeMin[CAPACITE_DIMENSIONS];
+    for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+    {
+        chargeMin[d] = FLT_MAX;
+        for (int k = 0; k < n; k++)
+        {
+            int i = ordre ? ordre[k] : k;
+            if (colis->charge[d][i] < chargeMin[d])
+                chargeMin[d] = colis->charge[d][i];
+        }
+    }
+    VehicleIndex *index = createVehicleIndex(flotte, carte->V, chargeMin, mode);
+    if (!index)
+        return -1;
+
+    int affectes = 0;
+    for (int k = 0; k < n; k++)
+    {
+        int i = ordre ? ordre[k] : k;
+        float charge[CAPACITE_DIMENSIONS];
+        chargeDuColis(colis, i, charge);
+        int best = vehicleIndexBest(index, carte, colis->villeDest[i], charge, &distance[i]);
+        affectation[i] = best;
+        if (best < 0)
+            continue;
+        if (!ajouterLivraison(flotte, best, colis->villeDest[i]))
+        {
+            freeVehicleIndex(index);
+            return -1;
+        }
+        for (int d = 0; d < CAPACITE_DIMENSIONS; d++)
+            flotte->capaciteRestante[d][best] -= charge[d];
+        vehicleIndexUpdate(index, best);
+        affectes++;
+    }
+
+    freeVehicleIndex(index);
+    return affectes;
+}
+
+// Affecte tous les colis du lot par numéro croissant.
+// affectation[i] reçoit le véhicule du colis i (ou AFFECTATION_CAPACITE /
+// AFFECTATION_INACCESSIBLE), distance[i] sa distance. Retourne le nombre de colis affectés.
+int affecterColisIndexe(Flotte *flotte, const LotColis *colis, ModeAffectation mode, Carte *carte, int *affectation,
+                        float *distance)
+{
+    return affecterColisDansOrdre(flotte, colis, NULL, colis->count, mode, carte, affectation, distance);
+}
+
+// Vide la file en affectant ses colis par ordre de priorité (urgents d'abord, puis par
+// numéro) ; ordre reçoit les colis dans l'ordre de traitement (file->size entiers). Les colis absents de la file gardent leur affectation. Retourne le nombre de
+// colis affectés.
+int affecterColisFile(Flotte *flotte, const LotColis *colis, FileColis *file, ModeAffectation mode, Carte *carte,
+                      int *ordre, int *affectation, float *distance)
+{
+    int n = 0, i;
+    while ((i = fileColisExtraire(file)) >= 0)
+        ordre[n++] = i;
+    return affecterColisDansOrdre(flotte, colis, ordre, n, mode, carte, affectation, distance);
+}
+
+void affecterColis(Flotte *flotte, const LotColis *colis, ModeAffectation mode, Carte *carte, const CSRGraph *csr)
+{
+    printf("\n===== Affectation des colis aux véhicules (GLOUTONNE, urgents d'abord) =====\n");
+    int nbColis = colis->count;
+    int *ordre = (int *)malloc((nbColis > 0 ? nbColis : 1) * sizeof(int));
+    int *affectation = (int *)malloc((nbColis > 0 ? nbColis : 1) * sizeof(int));
+    float *distance = (float *)malloc((nbColis > 0 ? nbColis : 1) * sizeof(float));
+    FileColis file;
+    initialiserFileColis(&file);
+    bool ok = true;
+    for (int i = 0; i < nbColis && ok; i++)
+        ok = fileColisAjouter(&file, colis, i);
+    if (!ok || !ordre || !affectation || !distance ||
+        affecterColisFile(flotte, colis, &file, mode, carte, ordre, affectation, distance) < 0)
+    {
+        printf("Erreur : allocation mémoire échouée pour l'affectation des colis.\n");
+        libererFileColis(&file);
+        free(ordre);
+        free(affectation);
+        free(distance);
+        return;
+    }
+
+    for (int k = 0; k < nbColis; k++)
+    {
+        int i = ordre[k];
+        const char *urgent = colis->urgent[i] ? " [urgent]" : "";
+        if (affectation[i] >= 0)
+            printf("Colis %d%s affecté au véhicule %d (destination : %s, distance : %.1f km)\n", i, urgent,
+                   affectation[i], csrCityName(csr, colis->villeDest[i]), distance[i]);
+        else if (affectation[i] == AFFECTATION_INACCESSIBLE)
+            printf("Colis %d%s non assigné : aucun véhicule disponible ne peut rejoindre %s\n", i, urgent,
+                   csrCityName(csr, colis->villeDest[i]));
+        else
+            printf("Colis %d%s non assigné : aucun véhicule disponible avec la capacité suffisante (poids et volume)\n",
+                   i, urgent);
+    }
+    libererFileColis(&file);
+    free(ordre);
+    free(affectation);
+    free(distance);
+}
+
+// ---------- AFFICHAGE TOURNEE ----------
+void afficherTournees(const Flotte *flotte, const CSRGraph *csr)
+{
+    printf("\n===== Tournées des véhicules (GLOUTONNE) =====\n");
+    for (int i = 0; i < flotte->count; i++)
+    {
+        printf("Tournée du véhicule %d : ", i);
+        for (int l = flotte->premiereLivraison[i]; l >= 0; l = flotte->livraisonSuivante[l])
+        {
+            printf("-> %s ", csrCityName(csr, flotte->livraisonVille[l]));
+        }
+        printf("\n");
+    }
+}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// >>> BENCHMARKS
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Horloge murale en secondes (C11, disponible sous Linux comme sous MinGW)
+double chronometre(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Générateur pseudo-aléatoire (xorshift32) : reproductible et indépendant de rand()
+static unsigned int aleatoireSuivant(unsigned int *etat)
+{
+    unsigned int x = *etat;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *etat = x;
+    return x;
+}
+
+// Fonction pour générer un réseau routier synthétique de V villes et E routes.
+// Les arêtes sont insérées dans un ordre aléatoire, comme lors d'un chargement réel,
+// ce qui disperse les nœuds des listes chaînées en mémoire.
+Graph *genererGrapheAleatoire(int V, int E, unsigned int seed)
+{
+    Graph *graph = createGraph(V);
+    if (!graph)
+        return NULL;
+
+    unsigned int etat = seed ? seed : 1;
+    char name[32];
+    for (int i = 0; i < V; i++)
+    {
+        snprintf(name, sizeof(name), "V%d", i);
+        graph->cityNames[i] = strdup(name);
+    }
+
+    for (int i = 0; i < E; i++)
+    {
+        int src = aleatoireSuivant(&etat) % V;
+        int dest = aleatoireSuivant(&etat) % V;
+        EdgeAttr attr;
+        attr.distance = 1.0f + aleatoireSuivant(&etat) % 200;
+        attr.baseTime = attr.distance * (0.8f + (aleatoireSuivant(&etat) % 40) / 100.0f);
+        attr.cost = 500.0f + aleatoireSuivant(&etat) % 9500;
+        attr.roadType = aleatoireSuivant(&etat) % 3;
+        attr.reliability = 0.7f + (aleatoireSuivant(&etat) % 30) / 100.0f;
+        attr.restrictions = 0;
+        attr.toll = aleatoireSuivant(&etat) % 3;
+        addEdge(graph, src, dest, attr);
+    }
+
+    return graph;
+}
+
+// Fonction pour générer un réseau routier maillé de largeur x hauteur villes : chaque ville
+// est reliée à ses voisines de la grille, dans les deux sens, avec une probabilité de 90 %.
+// Contrairement à genererGrapheAleatoire, la structure ressemble à un vrai réseau routier
+// (peu de longues liaisons), ce qui est le cas d'usage des hiérarchies de contraction.
+Graph *genererGrilleRoutiere(int largeur, int hauteur, unsigned int seed)
+{
+    int V = largeur * hauteur;
+    Graph *graph = createGraph(V);
+    if (!graph)
+        return NULL;
+
+    unsigned int etat = seed ? seed : 1;
+    char name[32];
+    for (int i = 0; i < V; i++)
+    {
+        snprintf(name, sizeof(name), "G%d", i);
+        graph->cityNames[i] = strdup(name);
+    }
+
+    for (int y = 0; y < hauteur; y++)
+    {
+        for (int x = 0; x < largeur; x++)
+        {
+            int u = y * largeur + x;
+            int voisins[2] = {x + 1 < largeur ? u + 1 : -1, y + 1 < hauteur ? u + largeur : -1};
+            for (int k = 0; k < 2; k++)
+            {
+                if (voisins[k] < 0 || aleatoireSuivant(&etat) % 10 == 0)
+                    continue;
+                EdgeAttr attr;
+                attr.distance = 5.0f + aleatoireSuivant(&etat) % 60;
+                attr.baseTime = attr.distance * (0.8f + (aleatoireSuivant(&etat) % 40) / 100.0f);
+                attr.cost = 500.0f + aleatoireSuivant(&etat) % 9500;
+                attr.roadType = aleatoireSuivant(&etat) % 3;
+                attr.reliability = 0.7f + (aleatoireSuivant(&etat) % 30) / 100.0f;
+                attr.restrictions = 0;
+                attr.toll = aleatoireSuivant(&etat) % 3;
+                addEdge(graph, u, voisins[k], attr);
+                addEdge(graph, voisins[k], u, attr);
+            }
+        }
+    }
+
+    return graph;
+}
+
+// Longue chaîne de tronçons 0 -> 1 -> ... -> N-1, avec quelques raccourcis vers l'avant
+// (le graphe reste acyclique) ; boucle ajoute l'arc N-1 -> 0, qui fait de la chaîne un
+// seul circuit. Le parcours en profondeur y descend à une profondeur de l'ordre de N.
+Graph *genererChaineRoutiere(int N, bool boucle, unsigned int seed)
+{
+    Graph *graph = createGraph(N);
+    if (!graph)
+        return NULL;
+
+    unsigned int etat = seed ? seed : 1;
+    char name[32];
+    for (int i = 0; i < N; i++)
+    {
+        snprintf(name, sizeof(name), "C%d", i);
+        graph->cityNames[i] = strdup(name);
+    }
+
+    EdgeAttr attr = {0};
+    for (int i = 0; i + 1 < N; i++)
+    {
+        attr.distance = 1.0f + aleatoireSuivant(&etat) % 20;
+        attr.baseTime = attr.distance;
+        attr.cost = 100.0f;
+        addEdge(graph, i, i + 1, attr);
+        if (i + 3 < N && aleatoireSuivant(&etat) % 8 == 0)
+            addEdge(graph, i, i + 3, attr);
+    }
+    if (boucle && N > 1)
+        addEdge(graph, N - 1, 0, attr);
+
+    return graph;
+}
+
+// Une passe de relaxation de Bellman-Ford sur les listes chaînées
+static int passeRelaxationListe(Graph *graph, float *dist)
+{
+    int updates = 0;
+    for (int u = 0; u < graph->V; u++)
+    {
+        for (AdjListNode *node = graph->array[u].head; node; node = node->next)
+        {
+            if (dist[u] + node->attr.cost < dist[node->dest])
+            {
+                dist[node->dest] = dist[u] + node->attr.cost;
+                updates++;
+            }
+        }
+    }
+    return updates;
+}
+
+// La même passe sur le graphe CSR
+static int passeRelaxationCSR(const CSRGraph *csr, float *dist)
+{
+    int updates = 0;
+    for (int u = 0; u < csr->V; u++)
+    {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+        {
+            if (dist[u] + csr->cost[e] < dist[csr->dest[e]])
+            {
+                dist[csr->dest[e]] = dist[u] + csr->cost[e];
+                updates++;
+            }
+        }
+    }
+    return updates;
+}
+
+// Parcours en largeur complet sans affichage (retourne le nombre de sommets atteints)
+static int parcoursLargeurListe(Graph *graph, int start, bool *visited, int *queue)
+{
+    memset(visited, 0, graph->V * sizeof(bool));
+    int front = 0, rear = 0;
+    visited[start] = true;
+    queue[rear++] = start;
+    while (front < rear)
+    {
+        int current = queue[front++];
+        for (AdjListNode *node = graph->array[current].head; node; node = node->next)
+        {
+            if (!visited[node->dest])
+            {
+                visited[node->dest] = true;
+                queue[rear++] = node->dest;
+            }
+        }
+    }
+    return rear;
+}
+
+static int parcoursLargeurCSR(const CSRGraph *csr, int start, bool *visited, int *queue)
+{
+    memset(visited, 0, csr->V * sizeof(bool));
+    int front = 0, rear = 0;
+    visited[start] = true;
+    queue[rear++] = start;
+    while (front < rear)
+    {
+        int current = queue[front++];
+        for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++)
+        {
+            if (!visited[csr->dest[e]])
+            {
+                visited[csr->dest[e]] = true;
+                queue[rear++] = csr->dest[e];
+            }
+        }
+    }
+    return rear;
+}
+
+// Benchmark : coût d'une passe sur les listes chaînées comparé au CSR
+// Usage : main --bench csr [V] [E] [passes]
+static int benchmarkCSR(int argc, char *argv[])
+{
+    int V = argc > 0 ? atoi(argv[0]) : 100000;
+    int E = argc > 1 ? atoi(argv[1]) : 500000;
+    int passes = argc > 2 ? atoi(argv[2]) : 10;
+    if (V < 1 || E < 0 || passes < 1)
+    {
+        printf("Erreur : paramètres de benchmark invalides.\n");
+        return 1;
+    }
+
+    printf("Graphe synthétique : %d sommets, %d arêtes, %d passes\n", V, E, passes);
+    Graph *graph = genererGrapheAleatoire(V, E, 12345);
+    if (!graph)
+        return 1;
+
+    double t0 = chronometre();
+    CSRGraph *csr = buildCSR(graph);
+    double tBuild = chronometre() - t0;
+    if (!csr)
+    {
+        freeGraph(graph);
+        return 1;
+    }
+
+    float *dist = malloc(V * sizeof(float));
+    bool *visited = malloc(V * sizeof(bool));
+    int *queue = malloc(V * sizeof(int));
+    if (!dist || !visited || !queue)
+    {
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+        free(dist);
+        free(visited);
+        free(queue);
+        freeCSR(csr);
+        freeGraph(graph);
+        return 1;
+    }
+
+    // Relaxation : on repart de la même initialisation pour chaque représentation
+    double tListe = 0, tCSR = 0;
+    long checkListe = 0, checkCSR = 0;
+    for (int p = 0; p < passes; p++)
+    {
+        for (int i = 0; i < V; i++)
+            dist[i] = (i == 0) ? 0 : INF;
+        t0 = chronometre();
+        checkListe += passeRelaxationListe(graph, dist);
+        tListe += chronometre() - t0;
+
+        for (int i = 0; i < V; i++)
+            dist[i] = (i == 0) ? 0 : INF;
+        t0 = chronometre();
+        checkCSR += passeRelaxationCSR(csr, dist);
+        tCSR += chronometre() - t0;
+    }
+
+    // Parcours en largeur complet
+    double tBfsListe = 0, tBfsCSR = 0;
+    long reachListe = 0, reachCSR = 0;
+    for (int p = 0; p < passes; p++)
+    {
+        t0 = chronometre();
+        reachListe += parcoursLargeurListe(graph, p % V, visited, queue);
+        tBfsListe += chronometre() - t0;
+
+        t0 = chronometre();
+        reachCSR += parcoursLargeurCSR(csr, p % V, visited, queue);
+        tBfsCSR += chronometre() - t0;
+    }
+
+    printf("Construction CSR          : %8.3f ms\n", tBuild * 1e3);
+    printf("Passe de relaxation liste : %8.3f ms\n", tListe / passes * 1e3);
+    printf("Passe de relaxation CSR   : %8.3f ms  (x%.2f)\n", tCSR / passes * 1e3, tListe / tCSR);
+    printf("BFS complet liste         : %8.3f ms\n", tBfsListe / passes * 1e3);
+    printf("BFS complet CSR           : %8.3f ms  (x%.2f)\n", tBfsCSR / passes * 1e3, tBfsListe / tBfsCSR);
+    if (checkListe != checkCSR || reachListe != reachCSR)
+        printf("Attention : résultats différents entre les deux représentations.\n");
+
+    free(dist);
+    free(visited);
+    free(queue);
+    freeCSR(csr);
+    freeGraph(graph);
+    return 0;
+}
+
+// Ancien parcours indexé des arêtes (cJSON_GetArrayItem + cJSON_GetObjectItem), pour comparaison
+static double parcoursIndexeAretes(cJSON *edges)
+{
+    double somme = 0;
+    int edgeCount = cJSON_GetArraySize(edges);
+    for (int i = 0; i < edgeCount; i++)
+    {
+        cJSON *edge = cJSON_GetArrayItem(edges, i);
+        somme += cJSON_GetObjectItem(edge, "src")->valueint + cJSON_GetObjectItem(edge, "cost")->valuedouble;
+    }
+    return somme;
+}
+
+// Comparaison de deux graphes chaînés (mêmes noms, mêmes arêtes dans le même ordre)
+static bool memesGraphes(Graph *a, Graph *b)
+{
+    if (a->V != b->V)
         return false;
+    for (int u = 0; u < a->V; u++)
+    {
+        if (strcmp(a->cityNames[u] ? a->cityNames[u] : "", b->cityNames[u] ? b->cityNames[u] : "") != 0)
+            return false;
+        AdjListNode *na = a->array[u].head, *nb = b->array[u].head;
+        for (; na && nb; na = na->next, nb = nb->next)
+        {
+            if (na->dest != nb->dest || memcmp(&na->attr, &nb->attr, sizeof(EdgeAttr)) != 0)
+                return false;
+        }
+        if (na || nb)
+            return false;
+    }
+    return true;
+}
+
+// Benchmark : temps de chargement de graph.json synthétiques de taille croissante
+// Usage : main --bench chargement [E1 E2 ...]   (par défaut 10000 100000 1000000)
+static int benchmarkChargement(int argc, char *argv[])
+{
+    int defaults[] = {10000, 100000, 1000000};
+    int nbTailles = argc > 0 ? argc : 3;
+    const char *filename = "bench_graph.json";
+
+    printf("%10s %10s %12s %12s %12s %12s %16s\n", "aretes", "sommets", "cJSON", "ns/arete",
+           "flux (SAX)", "ns/arete", "ancien parcours");
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        int V = E / 5 > 1 ? E / 5 : 2;
+
+        Graph *graph = genererGrapheAleatoire(V, E, 2024 + t);
+        if (!graph || !saveGraphToJSON(graph, filename))
+        {
+            if (graph)
+                freeGraph(graph);
+            return 1;
+        }
+        freeGraph(graph);
+
+        double t0 = chronometre();
+        Graph *loaded = loadGraphFromJSON(filename);
+        double tLoad = chronometre() - t0;
+
+        t0 = chronometre();
+        Graph *streamed = loadGraphFromJSONStream(filename);
+        double tStream = chronometre() - t0;
+        if (!loaded || !streamed)
+        {
+            if (loaded)
+                freeGraph(loaded);
+            if (streamed)
+                freeGraph(streamed);
+            remove(filename);
+            return 1;
+        }
+        if (!memesGraphes(loaded, streamed))
+            printf("Attention : les deux chargeurs produisent des graphes différents.\n");
+        freeGraph(loaded);
+        freeGraph(streamed);
+
+        // L'ancien parcours quadratique n'est mesuré que jusqu'à 20k arêtes (87 s à 100k)
+        char ancien[32] = "-";
+        if (E <= 20000)
+        {
+            char *jsonData = readFile(filename);
+            cJSON *json = jsonData ? cJSON_Parse(jsonData) : NULL;
+            if (json)
+            {
+                t0 = chronometre();
+                parcoursIndexeAretes(cJSON_GetObjectItem(json, "edges"));
+                snprintf(ancien, sizeof(ancien), "%.1f ms", (chronometre() - t0) * 1e3);
+            }
+            cJSON_Delete(json);
+            free(jsonData);
+        }
+
+        printf("%10d %10d %9.1f ms %12.1f %9.1f ms %12.1f %16s\n", E, V, tLoad * 1e3, tLoad * 1e9 / E,
+               tStream * 1e3, tStream * 1e9 / E, ancien);
+        remove(filename);
+    }
+    return 0;
+}
+
+// Benchmark : démarrage depuis graph.json comparé à l'ouverture de l'instantané
+// Usage : main --bench instantane [V] [E]
+static int benchmarkInstantane(int argc, char *argv[])
+{
+    int V = argc > 0 ? atoi(argv[0]) : 200000;
+    int E = argc > 1 ? atoi(argv[1]) : 1000000;
+    const char *jsonFile = "bench_graph.json";
+    const char *snapshotFile = "bench_graph.bin";
+
+    Graph *graph = genererGrapheAleatoire(V, E, 77);
+    if (!graph || !saveGraphToJSON(graph, jsonFile))
+    {
+        if (graph)
+            freeGraph(graph);
+        return 1;
+    }
+    freeGraph(graph);
+    printf("Graphe synthétique : %d sommets, %d arêtes\n", V, E);
+
+    double t0 = chronometre();
+    graph = loadGraphFromJSONStream(jsonFile);
+    CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+    double tJson = chronometre() - t0;
+    if (graph)
+        freeGraph(graph);
+    if (!csr || !saveCSRSnapshot(csr, snapshotFile, jsonFile))
+    {
+        freeCSR(csr);
+        remove(jsonFile);
+        return 1;
+    }
+
+    t0 = chronometre();
+    CSRGraph *mapped = openCSRSnapshot(snapshotFile, jsonFile, false);
+    double tMap = chronometre() - t0;
+    t0 = chronometre();
+    CSRGraph *checked = openCSRSnapshot(snapshotFile, jsonFile, true);
+    double tChecked = chronometre() - t0;
+
+    if (mapped && checked)
+    {
+        bool same = memcmp(csr->offsets, mapped->offsets, (V + 1) * sizeof(int)) == 0 &&
+                    memcmp(csr->dest, mapped->dest, E * sizeof(int)) == 0 &&
+                    memcmp(csr->cost, mapped->cost, E * sizeof(float)) == 0 &&
+                    memcmp(csr->names, mapped->names, csr->nameOffsets[V]) == 0;
+        printf("JSON (flux) + CSR          : %9.2f ms\n", tJson * 1e3);
+        printf("Instantané (mmap)          : %9.3f ms\n", tMap * 1e3);
+        printf("Instantané + vérification  : %9.3f ms\n", tChecked * 1e3);
+        if (!same)
+            printf("Attention : l'instantané diffère du graphe d'origine.\n");
+    }
+
+    freeCSR(csr);
+    freeCSR(mapped);
+    freeCSR(checked);
+    remove(jsonFile);
+    remove(snapshotFile);
+    return (mapped && checked) ? 0 : 1;
+}
+
+// Benchmark : Floyd-Warshall classique comparé à la version par tuiles, pour chaque noyau
+// Usage : main --bench floyd [V1 V2 ...]   (par défaut 500 2000 5000)
+static int benchmarkFloyd(int argc, char *argv[])
+{
+    int defaults[] = {500, 2000, 5000};
+    int nbTailles = argc > 0 ? argc : 3;
+    FWKernel kernels[] = {FW_KERNEL_SCALAIRE, FW_KERNEL_SSE, FW_KERNEL_AVX2};
+
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int V = argc > 0 ? atoi(argv[t]) : defaults[t];
+        if (V < 1)
+            continue;
+        Graph *graph = genererGrapheAleatoire(V, 4 * V, 99 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        DistMatrix *reference = createDistMatrix(V);
+        DistMatrix *dist = createDistMatrix(V);
+        if (!csr || !reference || !dist)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark (V = %d).\n", V);
+            freeDistMatrix(reference);
+            freeDistMatrix(dist);
+            freeCSR(csr);
+            if (graph)
+                freeGraph(graph);
+            return 1;
+        }
+
+        printf("V = %d\n", V);
+
+        // La version classique (O(V^3) sans tuiles) n'est mesurée que jusqu'à V = 2000
+        double tRef = 0;
+        bool hasReference = V <= 2000;
+        if (hasReference)
+        {
+            double t0 = chronometre();
+            floydWarshall(graph, reference);
+            tRef = chronometre() - t0;
+            printf("  %-10s %10.1f ms\n", "classique", tRef * 1e3);
+        }
+
+        for (int k = 0; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++)
+        {
+            if (floydWarshallResolveKernel(kernels[k]) != kernels[k])
+            {
+                printf("  %-10s non supporté par ce processeur\n", floydWarshallKernelName(kernels[k]));
+                continue;
+            }
+            floydWarshallInitCSR(csr, dist);
+            double t0 = chronometre();
+            floydWarshallBlocked(dist->data, V, dist->stride, kernels[k]);
+            double tBlock = chronometre() - t0;
+
+            printf("  %-10s %10.1f ms", floydWarshallKernelName(kernels[k]), tBlock * 1e3);
+            if (hasReference)
+            {
+                size_t differences = 0;
+                float maxDiff = 0;
+                for (int i = 0; i < V; i++)
+                {
+                    const float *a = distMatrixRow(dist, i), *b = distMatrixRow(reference, i);
+                    for (int j = 0; j < V; j++)
+                    {
+                        float diff = a[j] > b[j] ? a[j] - b[j] : b[j] - a[j];
+                        if (diff != 0)
+                            differences++;
+                        if (diff > maxDiff)
+                            maxDiff = diff;
+                    }
+                }
+                printf("  (x%.2f, %zu écarts, max %.3g)", tRef / tBlock, differences, maxDiff);
+            }
+            printf("\n");
+        }
+
+        freeDistMatrix(reference);
+        freeDistMatrix(dist);
+        freeCSR(csr);
+        freeGraph(graph);
+    }
+    return 0;
+}
+
+// Benchmark : accélération de Floyd-Warshall par tuiles selon le nombre de threads
+// Usage : main --bench floyd-threads [V] [threadsMax]
+static int benchmarkFloydThreads(int argc, char *argv[])
+{
+    int V = argc > 0 ? atoi(argv[0]) : 2000;
+    int maxThreads = argc > 1 ? atoi(argv[1]) : nombreThreadsMax();
+    if (V < 1 || maxThreads < 1)
+    {
+        printf("Erreur : paramètres de benchmark invalides.\n");
+        return 1;
+    }
+#ifndef _OPENMP
+    printf("Compilé sans OpenMP (-fopenmp) : exécution sur un seul thread.\n");
+    maxThreads = 1;
+#endif
+
+    Graph *graph = genererGrapheAleatoire(V, 4 * V, 31);
+    CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+    if (graph)
+        freeGraph(graph);
+    DistMatrix *reference = createDistMatrix(V);
+    DistMatrix *dist = createDistMatrix(V);
+    if (!csr || !reference || !dist)
+    {
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+        freeDistMatrix(reference);
+        freeDistMatrix(dist);
+        freeCSR(csr);
+        return 1;
+    }
+
+    FWKernel kernel = floydWarshallResolveKernel(FW_KERNEL_AUTO);
+    printf("V = %d, noyau %s\n", V, floydWarshallKernelName(kernel));
+    printf("%8s %12s %10s %10s\n", "threads", "temps", "speedup", "résultat");
+
+    double tSeq = 0;
+    for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads)
+    {
+        DistMatrix *target = (threads == 1) ? reference : dist;
+        floydWarshallInitCSR(csr, target);
+        double t0 = chronometre();
+        floydWarshallParallel(target->data, V, target->stride, kernel, threads);
+        double t = chronometre() - t0;
+        if (threads == 1)
+            tSeq = t;
+        bool same = true;
+        for (int i = 0; i < V && threads > 1; i++)
+            same = same && memcmp(distMatrixRow(reference, i), distMatrixRow(dist, i), V * sizeof(float)) == 0;
+        printf("%8d %9.1f ms %9.2fx %10s\n", threads, t * 1e3, tSeq / t, same ? "identique" : "DIFFÉRENT");
+        if (threads == maxThreads)
+            break;
+    }
+
+    freeDistMatrix(reference);
+    freeDistMatrix(dist);
+    freeCSR(csr);
+    return 0;
+}
+
+// Benchmark : Dijkstra (tas 4-aire) comparé à Bellman-Ford sur des graphes de taille croissante
+// Usage : main --bench dijkstra [E1 E2 ...]   (par défaut 10000 100000 1000000)
+static int benchmarkDijkstra(int argc, char *argv[])
+{
+    int defaults[] = {10000, 100000, 1000000};
+    int nbTailles = argc > 0 ? argc : 3;
+
+    printf("%10s %10s %14s %14s %10s %10s\n", "aretes", "sommets", "Bellman-Ford", "Dijkstra", "speedup", "écarts");
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        int V = E / 5 > 1 ? E / 5 : 2;
+        Graph *graph = genererGrapheAleatoire(V, E, 4242 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        if (graph)
+            freeGraph(graph);
+        float *distBF = malloc(V * sizeof(float));
+        float *distDJ = malloc(V * sizeof(float));
+        int *pred = malloc(V * sizeof(int));
+        if (!csr || !distBF || !distDJ || !pred)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            free(distBF);
+            free(distDJ);
+            free(pred);
+            freeCSR(csr);
+            return 1;
+        }
+
+        // Sans contrainte de temps les deux algorithmes doivent donner les mêmes coûts
+        double t0 = chronometre();
+        dijkstraCSR(csr, 0, distDJ, pred, INF);
+        double tDJ = chronometre() - t0;
+
+        // Bellman-Ford fait V-1 passes complètes : mesuré seulement si V.E reste raisonnable
+        if ((double)V * E <= 2.5e9)
+        {
+            t0 = chronometre();
+            bellmanFordCSR(csr, 0, distBF, pred, INF);
+            double tBF = chronometre() - t0;
+            int differences = 0;
+            for (int i = 0; i < V; i++)
+                differences += distBF[i] != distDJ[i];
+            printf("%10d %10d %11.1f ms %11.2f ms %9.0fx %10d\n", E, V, tBF * 1e3, tDJ * 1e3, tBF / tDJ, differences);
+        }
+        else
+        {
+            printf("%10d %10d %14s %11.2f ms %10s %10s\n", E, V, "-", tDJ * 1e3, "-", "-");
+        }
+
+        free(distBF);
+        free(distDJ);
+        free(pred);
+        freeCSR(csr);
+    }
+    return 0;
+}
+
+// Benchmark : Bellman-Ford (arrêt anticipé) comparé à SPFA sur des coûts en partie négatifs.
+// Les coûts sont transformés par des potentiels aléatoires, cost'(u,v) = cost + p(u) - p(v) :
+// certaines arêtes deviennent négatives mais le poids des cycles, lui, ne change pas.
+// Usage : main --bench spfa [E1 E2 ...]   (par défaut 10000 100000 1000000)
+static int benchmarkSPFA(int argc, char *argv[])
+{
+    int defaults[] = {10000, 100000, 1000000};
+    int nbTailles = argc > 0 ? argc : 3;
+
+    printf("%10s %10s %10s %14s %14s %10s %10s\n", "aretes", "sommets", "négatives", "Bellman-Ford", "SPFA", "speedup", "écarts");
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        int V = E / 5 > 1 ? E / 5 : 2;
+        Graph *graph = genererGrapheAleatoire(V, E, 555 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        if (graph)
+            freeGraph(graph);
+        float *potential = malloc(V * sizeof(float));
+        float *distBF = malloc(V * sizeof(float));
+        float *distSPFA = malloc(V * sizeof(float));
+        int *pred = malloc(V * sizeof(int));
+        if (!csr || !potential || !distBF || !distSPFA || !pred)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            free(potential);
+            free(distBF);
+            free(distSPFA);
+            free(pred);
+            freeCSR(csr);
+            return 1;
+        }
+
+        unsigned int etat = 99 + t;
+        for (int v = 0; v < V; v++)
+            potential[v] = (float)(aleatoireSuivant(&etat) % 4000);
+        int negatives = 0;
+        for (int u = 0; u < V; u++)
+        {
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+            {
+                csr->cost[e] += potential[u] - potential[csr->dest[e]];
+                negatives += csr->cost[e] < 0;
+            }
+        }
+
+        double t0 = chronometre();
+        bellmanFordCSR(csr, 0, distBF, pred, INF);
+        double tBF = chronometre() - t0;
+        t0 = chronometre();
+        spfaCSR(csr, 0, distSPFA, pred, INF);
+        double tSPFA = chronometre() - t0;
+
+        int differences = 0;
+        for (int i = 0; i < V; i++)
+            differences += distBF[i] != distSPFA[i];
+        printf("%10d %10d %10d %11.1f ms %11.1f ms %9.1fx %10d\n", E, V, negatives, tBF * 1e3, tSPFA * 1e3,
+               tBF / tSPFA, differences);
+
+        free(potential);
+        free(distBF);
+        free(distSPFA);
+        free(pred);
+        freeCSR(csr);
+    }
+
+    // Contrôle de la détection : un cycle négatif explicite 0 -> 1 -> 2 -> 0
+    Graph *cycle = createGraph(3);
+    if (cycle)
+    {
+        EdgeAttr attr = {1.0f, 1.0f, 1.0f, 0, 1.0f, 0, 0};
+        addEdge(cycle, 0, 1, attr);
+        addEdge(cycle, 1, 2, attr);
+        attr.cost = -5.0f;
+        addEdge(cycle, 2, 0, attr);
+        for (int i = 0; i < 3; i++)
+            cycle->cityNames[i] = strdup("C");
+        CSRGraph *csr = buildCSR(cycle);
+        float dist[3];
+        int pred[3];
+        if (csr)
+            printf("Cycle négatif détecté par SPFA : %s\n", spfaCSR(csr, 0, dist, pred, INF) ? "NON" : "OUI");
+        freeCSR(csr);
+        freeGraph(cycle);
+    }
+    return 0;
+}
+
+// Benchmark : plus court chemin sous contrainte de temps, une étiquette par sommet
+// (dijkstraCSR) comparé aux étiquettes de Pareto (rcspCSR). On compte les sommets dont
+// le coût est amélioré, les étiquettes créées et étendues, puis on vérifie que la
+// recherche vers une cible unique (arrêt anticipé) retrouve le même coût optimal.
+// Usage : main --bench rcsp [maxTime] [E1 E2 ...]   (par défaut 600, 10000 100000 1000000)
+static int benchmarkRCSP(int argc, char *argv[])
+{
+    int defaults[] = {10000, 100000, 1000000};
+    float maxTime = argc > 0 ? (float)atof(argv[0]) : 600.0f;
+    int nbTailles = argc > 1 ? argc - 1 : 3;
+    const int nbCibles = 20;
+
+    printf("Budget de temps : %.0f\n", maxTime);
+    printf("%10s %10s %12s %12s %10s %12s %12s %8s %10s %12s %8s\n", "aretes", "sommets", "Dijkstra", "Pareto",
+           "améliorés", "étiquettes", "étendues", "front", "invalides", "cible (moy)", "écarts");
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int E = argc > 1 ? atoi(argv[t + 1]) : defaults[t];
+        int V = E / 5 > 1 ? E / 5 : 2;
+        Graph *graph = genererGrapheAleatoire(V, E, 8080 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        if (graph)
+            freeGraph(graph);
+        float *dist = malloc(V * sizeof(float));
+        int *pred = malloc(V * sizeof(int));
+        float *optimal = malloc(V * sizeof(float));
+        RCSPLabels *labels = createRCSPLabels(V);
+        if (!csr || !dist || !pred || !optimal || !labels)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            free(dist);
+            free(pred);
+            free(optimal);
+            freeRCSPLabels(labels);
+            freeCSR(csr);
+            return 1;
+        }
+
+        double t0 = chronometre();
+        dijkstraCSR(csr, 0, dist, pred, maxTime);
+        double tDJ = chronometre() - t0;
+        t0 = chronometre();
+        bool ok = rcspCSR(csr, 0, -1, maxTime, labels);
+        double tRCSP = chronometre() - t0;
+        if (!ok)
+        {
+            free(dist);
+            free(pred);
+            free(optimal);
+            freeRCSPLabels(labels);
+            freeCSR(csr);
+            return 1;
+        }
+
+        // Un chemin trouvé par Dijkstra respecte le budget : le coût exact ne peut être que <=
+        int ameliores = 0, invalides = 0, front = 0;
+        for (int v = 0; v < V; v++)
+        {
+            int best = labels->head[v];
+            optimal[v] = best >= 0 ? labels->cost[best] : INF;
+            ameliores += optimal[v] < dist[v];
+            invalides += optimal[v] > dist[v];
+            int taille = 0;
+            for (int l = best; l >= 0; l = labels->nextAtNode[l])
+                taille++;
+            if (taille > front)
+                front = taille;
+        }
+        int etiquettes = labels->count, etendues = labels->settled;
+
+        unsigned int etat = 31 + t;
+        int differences = 0;
+        t0 = chronometre();
+        for (int q = 0; q < nbCibles; q++)
+        {
+            int cible = aleatoireSuivant(&etat) % V;
+            if (!rcspCSR(csr, 0, cible, maxTime, labels))
+                break;
+            int best = labels->head[cible];
+            differences += (best >= 0 ? labels->cost[best] : INF) != optimal[cible];
+        }
+        double tCible = (chronometre() - t0) / nbCibles;
+
+        printf("%10d %10d %9.1f ms %9.1f ms %10d %12d %12d %8d %10d %9.2f ms %8d\n", E, V, tDJ * 1e3, tRCSP * 1e3,
+               ameliores, etiquettes, etendues, front, invalides, tCible * 1e3, differences);
+
+        free(dist);
+        free(pred);
+        free(optimal);
+        freeRCSPLabels(labels);
+        freeCSR(csr);
     }
+    return 0;
+}
 
-    for (int i = 0; i < graph->V; i++)
-        visited[i] = false;
+// Benchmark : K appels de bellmanFordCSR comparés à un seul appel groupé
+// bellmanFordBatchCSR, en requêtes (source, tous les sommets) par seconde.
+// Usage : main --bench lot [E] [maxTime] [K1 K2 ...]   (par défaut 100000, 600, 1 8 32 64)
+static int benchmarkLot(int argc, char *argv[])
+{
+    int defaults[] = {1, 8, 32, 64};
+    int E = argc > 0 ? atoi(argv[0]) : 100000;
+    float maxTime = argc > 1 ? (float)atof(argv[1]) : 600.0f;
+    int nbLots = argc > 2 ? argc - 2 : 4;
+    int V = E / 5 > 1 ? E / 5 : 2;
 
-    int *queue = malloc(graph->V * sizeof(int));
-    if (!queue)
+    Graph *graph = genererGrapheAleatoire(V, E, 2024);
+    CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+    if (graph)
+        freeGraph(graph);
+    float *dist = malloc(V * sizeof(float));
+    float *distLot = malloc(V * sizeof(float));
+    int *pred = malloc(V * sizeof(int));
+    int *predLot = malloc(V * sizeof(int));
+    if (!csr || !dist || !distLot || !pred || !predLot)
     {
-        printf("Erreur : allocation mémoire échouée pour la file.\n");
-        free(visited);
-        return false;
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+        free(dist);
+        free(distLot);
+        free(pred);
+        free(predLot);
+        freeCSR(csr);
+        return 1;
     }
 
-    int front = 0, rear = 0;
-    queue[rear++] = src;
-    visited[src] = true;
-
-    while (front < rear)
+    printf("Graphe : %d sommets, %d arêtes, budget de temps %.0f (%s)\n", V, E, maxTime,
+           floydWarshallResolveKernel(FW_KERNEL_AUTO) == FW_KERNEL_AVX2 ? "avx2" : "scalaire");
+    printf("%8s %14s %14s %14s %14s %10s %10s\n", "sources", "un par un", "groupé", "req/s (1x1)", "req/s (lot)",
+           "speedup", "écarts");
+    for (int t = 0; t < nbLots; t++)
     {
-        int current = queue[front++];
-        if (current == dest)
+        int K = argc > 2 ? atoi(argv[t + 2]) : defaults[t];
+        int *sources = malloc(K * sizeof(int));
+        MultiSourcePaths *paths = createMultiSourcePaths(V, K);
+        if (!sources || !paths)
         {
-            free(queue);
-            free(visited);
-            return true;
+            free(sources);
+            freeMultiSourcePaths(paths);
+            break;
         }
+        unsigned int etat = 77 + K;
+        for (int s = 0; s < K; s++)
+            sources[s] = aleatoireSuivant(&etat) % V;
 
-        AdjListNode *node = graph->array[current].head;
-        while (node)
+        double t0 = chronometre();
+        bellmanFordBatchCSR(csr, sources, maxTime, paths);
+        double tLot = chronometre() - t0;
+
+        // Les résultats doivent être identiques à ceux de bellmanFordCSR, source par source
+        int differences = 0;
+        double tUn = 0;
+        for (int s = 0; s < K; s++)
         {
-            if (!visited[node->dest])
-            {
-                visited[node->dest] = true;
-                queue[rear++] = node->dest;
-            }
-            node = node->next;
+            t0 = chronometre();
+            bellmanFordCSR(csr, sources[s], dist, pred, maxTime);
+            tUn += chronometre() - t0;
+            multiSourceColumn(paths, s, distLot, predLot);
+            for (int v = 0; v < V; v++)
+                differences += dist[v] != distLot[v] || pred[v] != predLot[v];
         }
+
+        printf("%8d %11.1f ms %11.1f ms %14.0f %14.0f %9.1fx %10d\n", K, tUn * 1e3, tLot * 1e3, K / tUn, K / tLot,
+               tUn / tLot, differences);
+        free(sources);
+        freeMultiSourcePaths(paths);
     }
 
-    free(queue);
-    free(visited);
-    return false;
+    // Contrôle de la détection : chaîne 2 -> 1 -> 0, dont la dernière étiquette n'est fixée
+    // qu'à la passe V-1 ; aucun cycle ne doit être signalé
+    Graph *chaine = createGraph(3);
+    if (chaine)
+    {
+        EdgeAttr attr = {1.0f, 1.0f, 1.0f, 0, 1.0f, 0, 0};
+        addEdge(chaine, 2, 1, attr);
+        addEdge(chaine, 1, 0, attr);
+        for (int i = 0; i < 3; i++)
+            chaine->cityNames[i] = strdup("C");
+        CSRGraph *petit = buildCSR(chaine);
+        MultiSourcePaths *paths = createMultiSourcePaths(3, 1);
+        int source = 2;
+        if (petit && paths)
+        {
+            bool ok = bellmanFordBatchCSR(petit, &source, INF, paths);
+            bellmanFordCSR(petit, source, dist, pred, INF);
+            multiSourceColumn(paths, 0, distLot, predLot);
+            int differences = 0;
+            for (int v = 0; v < 3; v++)
+                differences += dist[v] != distLot[v] || pred[v] != predLot[v];
+            printf("Chaîne 2 -> 1 -> 0 : %s, %d écarts\n", ok ? "aucun cycle signalé" : "cycle signalé à tort",
+                   differences);
+        }
+        freeMultiSourcePaths(paths);
+        freeCSR(petit);
+        freeGraph(chaine);
+    }
+
+    free(dist);
+    free(distLot);
+    free(pred);
+    free(predLot);
+    freeCSR(csr);
+    return 0;
 }
 
-// Statistiques de connectivité
-void calculateConnectivityStats(Graph *graph)
+// Somme des coûts le long de path (arête la moins chère entre deux sommets consécutifs),
+// -1 si deux sommets consécutifs ne sont pas reliés
+static float coutChemin(const CSRGraph *csr, const int *path, int length)
 {
-    int totalEdges = 0;
-    for (int i = 0; i < graph->V; i++)
+    float total = 0;
+    for (int j = 0; j + 1 < length; j++)
     {
-        AdjListNode *node = graph->array[i].head;
-        while (node)
+        float best = -1;
+        for (int e = csr->offsets[path[j]]; e < csr->offsets[path[j] + 1]; e++)
         {
-            totalEdges++;
-            node = node->next;
+            if (csr->dest[e] == path[j + 1] && (best < 0 || csr->cost[e] < best))
+                best = csr->cost[e];
         }
+        if (best < 0)
+            return -1;
+        total += best;
     }
+    return total;
+}
+
+static bool prochesFlottants(float a, float b)
+{
+    float ecart = a > b ? a - b : b - a;
+    return ecart <= 1e-4f * (b > 1 ? b : 1);
+}
 
-    if (graph->V > 1)
+// Benchmark : hiérarchie de contraction sur des grilles routières. Mesure le prétraitement,
+// le rechargement depuis le fichier, puis des requêtes point à point aléatoires (avec
+// dépliage du chemin) comparées à dijkstraCSR ; les longueurs et les chemins dépliés sont
+// vérifiés.
+// Usage : main --bench ch [côté1 côté2 ...]   (par défaut 50 100 200)
+static int benchmarkCH(int argc, char *argv[])
+{
+    int defaults[] = {50, 100, 200};
+    int nbTailles = argc > 0 ? argc : 3;
+    const int nbRequetes = 1000, nbControles = 50;
+    const char *fichier = "bench_graph.ch";
+
+    printf("%8s %8s %12s %10s %12s %12s %12s %10s %8s\n", "sommets", "aretes", "prétraitement", "raccourcis",
+           "rechargement", "requête CH", "Dijkstra", "speedup", "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        float density = (totalEdges * 100.0) / (graph->V * (graph->V - 1));
-        printf("Densité: %.2f%%\n", density);
+        int cote = argc > 0 ? atoi(argv[t]) : defaults[t];
+        Graph *graph = genererGrilleRoutiere(cote, cote, 321 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        if (graph)
+            freeGraph(graph);
+        if (!csr)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            return 1;
+        }
+        int V = csr->V;
+
+        double t0 = chronometre();
+        CHGraph *built = buildContractionHierarchy(csr, METRIC_COST);
+        double tBuild = chronometre() - t0;
+        bool saved = built && saveContractionHierarchy(built, fichier);
+        t0 = chronometre();
+        CHGraph *ch = saved ? loadContractionHierarchy(fichier, csr, METRIC_COST) : NULL;
+        double tLoad = chronometre() - t0;
+        remove(fichier);
+
+        CHQuery *query = createCHQuery(V);
+        int *path = malloc(V * sizeof(int));
+        float *dist = malloc(V * sizeof(float));
+        int *pred = malloc(V * sizeof(int));
+        int *paires = malloc(2 * nbRequetes * sizeof(int));
+        if (!ch || !query || !path || !dist || !pred || !paires)
+        {
+            printf("Erreur : construction ou rechargement de la hiérarchie impossible.\n");
+            freeContractionHierarchy(built);
+            freeContractionHierarchy(ch);
+            freeCHQuery(query);
+            free(path);
+            free(dist);
+            free(pred);
+            free(paires);
+            freeCSR(csr);
+            return 1;
+        }
+
+        unsigned int etat = 4000 + t;
+        for (int q = 0; q < 2 * nbRequetes; q++)
+            paires[q] = aleatoireSuivant(&etat) % V;
+
+        int length;
+        t0 = chronometre();
+        for (int q = 0; q < nbRequetes; q++)
+            chQuery(ch, query, paires[2 * q], paires[2 * q + 1], path, &length);
+        double tCH = (chronometre() - t0) / nbRequetes;
+
+        // Contrôle : longueur égale à Dijkstra et chemin déplié cohérent avec cette longueur
+        int differences = 0;
+        double tDJ = 0;
+        for (int q = 0; q < nbControles; q++)
+        {
+            int s = paires[2 * q], cible = paires[2 * q + 1];
+            t0 = chronometre();
+            dijkstraCSR(csr, s, dist, pred, INF);
+            tDJ += chronometre() - t0;
+            float longueur = chQuery(ch, query, s, cible, path, &length);
+            if (dist[cible] == INF || longueur == INF)
+                differences += (dist[cible] == INF) != (longueur == INF);
+            else
+                differences += !prochesFlottants(longueur, dist[cible]) || path[0] != s ||
+                               path[length - 1] != cible || !prochesFlottants(coutChemin(csr, path, length), longueur);
+        }
+        tDJ /= nbControles;
+
+        printf("%8d %8d %10.0f ms %10d %9.2f ms %9.1f us %9.2f ms %9.0fx %8d\n", V, csr->E, tBuild * 1e3, ch->shortcuts,
+               tLoad * 1e3, tCH * 1e6, tDJ * 1e3, tDJ / tCH, differences);
+
+        freeContractionHierarchy(built);
+        freeContractionHierarchy(ch);
+        freeCHQuery(query);
+        free(path);
+        free(dist);
+        free(pred);
+        free(paires);
+        freeCSR(csr);
     }
-    else
+    return 0;
+}
+
+// Benchmark : A* avec repères (ALT) comparé à Dijkstra point à point (arrêté à la cible)
+// sur des grilles routières : sommets fixés et temps moyens par requête, longueurs vérifiées.
+// Usage : main --bench alt [repères] [côté1 côté2 ...]   (par défaut 8, 100 200 300)
+static int benchmarkALT(int argc, char *argv[])
+{
+    int defaults[] = {100, 200, 300};
+    int K = argc > 0 ? atoi(argv[0]) : ALT_LANDMARKS;
+    int nbTailles = argc > 1 ? argc - 1 : 3;
+    const int nbRequetes = 200;
+
+    printf("Repères : %d, critère : coût\n", K);
+    printf("%8s %8s %12s %14s %14s %10s %12s %12s %8s\n", "sommets", "aretes", "repères", "fixés Dijkstra",
+           "fixés ALT", "réduction", "Dijkstra", "ALT", "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        printf("Densité: Non applicable (graphe avec moins de 2 sommets).\n");
+        int cote = argc > 1 ? atoi(argv[t + 1]) : defaults[t];
+        Graph *graph = genererGrilleRoutiere(cote, cote, 654 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        if (graph)
+            freeGraph(graph);
+        ReverseCSR *reverse = csr ? buildReverseCSR(csr) : NULL;
+        AStarQuery *query = csr ? createAStarQuery(csr->V) : NULL;
+        double t0 = chronometre();
+        LandmarkIndex *alt = reverse ? buildLandmarkIndex(csr, reverse, METRIC_COST, K) : NULL;
+        double tPre = chronometre() - t0;
+        if (!alt || !query)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            freeLandmarkIndex(alt);
+            freeAStarQuery(query);
+            freeReverseCSR(reverse);
+            freeCSR(csr);
+            return 1;
+        }
+
+        unsigned int etat = 1234 + t;
+        long long fixesDJ = 0, fixesALT = 0;
+        double tDJ = 0, tALT = 0;
+        int differences = 0;
+        for (int q = 0; q < nbRequetes; q++)
+        {
+            int s = aleatoireSuivant(&etat) % csr->V, cible = aleatoireSuivant(&etat) % csr->V;
+            t0 = chronometre();
+            float dDJ = astarQuery(csr, NULL, METRIC_COST, query, s, cible, NULL, NULL);
+            tDJ += chronometre() - t0;
+            fixesDJ += query->settled;
+
+            t0 = chronometre();
+            float dALT = astarQuery(csr, alt, METRIC_COST, query, s, cible, NULL, NULL);
+            tALT += chronometre() - t0;
+            fixesALT += query->settled;
+
+            if (dDJ == INF || dALT == INF)
+                differences += (dDJ == INF) != (dALT == INF);
+            else
+                differences += !prochesFlottants(dALT, dDJ);
+        }
+
+        printf("%8d %8d %9.1f ms %14lld %14lld %9.1fx %9.3f ms %9.3f ms %8d\n", csr->V, csr->E, tPre * 1e3,
+               fixesDJ / nbRequetes, fixesALT / nbRequetes, (double)fixesDJ / (fixesALT ? fixesALT : 1),
+               tDJ / nbRequetes * 1e3, tALT / nbRequetes * 1e3, differences);
+
+        freeLandmarkIndex(alt);
+        freeAStarQuery(query);
+        freeReverseCSR(reverse);
+        freeCSR(csr);
     }
+    return 0;
 }
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// >>> FONCTION PRINCIPALE
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-int main(int argc, char *argv[])
+// Benchmark : tests d'accessibilité aléatoires, BFS simple (isAccessibleCSR) comparé au
+// BFS bidirectionnel à mémoire réutilisée, en requêtes par seconde.
+// Usage : main --bench acces [E1 E2 ...]   (par défaut 100000 1000000)
+static int benchmarkAcces(int argc, char *argv[])
 {
+    int defaults[] = {100000, 1000000};
+    int nbTailles = argc > 0 ? argc : 2;
+    const int nbRequetes = 500;
 
-    Graph *graph = loadGraphFromJSON("graph.json");
-    if (!graph)
+    printf("%10s %10s %12s %14s %14s %14s %10s %10s\n", "aretes", "sommets", "accessibles", "marqués (bidir)",
+           "req/s simple", "req/s bidir", "speedup", "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        printf("Erreur lors du chargement du graphe.\n");
-        return 1;
-    }
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        int V = E / 5 > 1 ? E / 5 : 2;
+        Graph *graph = genererGrapheAleatoire(V, E, 1717 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        if (graph)
+            freeGraph(graph);
+        ReverseCSR *reverse = csr ? buildReverseCSR(csr) : NULL;
+        ReachQuery *query = csr ? createReachQuery(V) : NULL;
+        int *paires = malloc(2 * nbRequetes * sizeof(int));
+        bool *attendu = malloc(nbRequetes * sizeof(bool));
+        if (!reverse || !query || !paires || !attendu)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            free(paires);
+            free(attendu);
+            freeReachQuery(query);
+            freeReverseCSR(reverse);
+            freeCSR(csr);
+            return 1;
+        }
 
-    // printGraph(graph);
-    // freeGraph(graph);
+        unsigned int etat = 909 + t;
+        for (int q = 0; q < 2 * nbRequetes; q++)
+            paires[q] = aleatoireSuivant(&etat) % V;
 
-    // Appel de DFS à partir du sommet 0 (par exemple, Abidjan)
-    dfs(graph, 0);
+        int accessibles = 0;
+        double t0 = chronometre();
+        for (int q = 0; q < nbRequetes; q++)
+        {
+            attendu[q] = isAccessibleCSR(csr, paires[2 * q], paires[2 * q + 1]);
+            accessibles += attendu[q];
+        }
+        double tSimple = chronometre() - t0;
 
-    // Appel de BFS à partir du sommet 0 (par exemple, Abidjan)
-    bfs(graph, 0);
+        int differences = 0;
+        long long marques = 0;
+        t0 = chronometre();
+        for (int q = 0; q < nbRequetes; q++)
+        {
+            differences += isAccessibleBidirectional(csr, reverse, query, paires[2 * q], paires[2 * q + 1]) != attendu[q];
+            marques += query->visited;
+        }
+        double tBidir = chronometre() - t0;
 
-    // Détecter les cycles dans le réseaus
-    printf("\n=== Analyse du réseau ===\n");
-    printf("Cycles détectés: %s\n", detectCycles(graph) ? "OUI" : "NON");
-    printf("\nComposantes connexes:\n");
-    findConnectedComponents(graph);
-    printf("\nAccessibilité Abidjan -> San-Pédro: %s\n",
-           isAccessible(graph, 0, 3) ? "OUI" : "NON");
-    printf("\nStatistiques:\n");
-    calculateConnectivityStats(graph);
+        printf("%10d %10d %12d %14lld %14.0f %14.0f %9.1fx %10d\n", E, V, accessibles, marques / nbRequetes,
+               nbRequetes / tSimple, nbRequetes / tBidir, tSimple / tBidir, differences);
 
-    // >>>>>>>>> Floyd-Warshall <<<<<<<<<<<
-    float distFW[graph->V][graph->V];
-    floydWarshall(graph, distFW);
-    printFloydWarshall(graph, distFW);
+        free(paires);
+        free(attendu);
+        freeReachQuery(query);
+        freeReverseCSR(reverse);
+        freeCSR(csr);
+    }
+    return 0;
+}
 
-    // >>>>>>>>>> Bellman-Ford <<<<<<<<<<<
-    int src = 0;         // Abidjan
-    float maxTime = 300; // En minutes, par exemple
+// Benchmark : index d'accessibilité. Construction, taille, requêtes par seconde comparées
+// au BFS bidirectionnel, puis insertions de routes avec mise à jour incrémentale, l'index
+// étant revérifié ensuite contre un BFS sur le graphe modifié.
+// Usage : main --bench index [E1 E2 ...]   (par défaut 100000 1000000, V = E / 2)
+static int benchmarkIndex(int argc, char *argv[])
+{
+    int defaults[] = {100000, 1000000};
+    int nbTailles = argc > 0 ? argc : 2;
+    const int nbRequetes = 100000, nbControles = 2000, nbInsertions = 1000;
+
+    printf("%9s %9s %8s %10s %12s %12s %12s %13s %8s\n", "aretes", "sommets", "CFC", "intervalles", "construction",
+           "req/s index", "req/s bidir", "insertion", "écarts");
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        int V = E / 2 > 1 ? E / 2 : 2;
+        Graph *graph = genererGrapheAleatoire(V, E, 3131 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        ReverseCSR *reverse = csr ? buildReverseCSR(csr) : NULL;
+        ReachQuery *query = csr ? createReachQuery(V) : NULL;
+        double t0 = chronometre();
+        ReachabilityIndex *index = reverse ? buildReachabilityIndex(csr) : NULL;
+        double tBuild = chronometre() - t0;
+        if (!index || !query)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            freeReachabilityIndex(index);
+            freeReachQuery(query);
+            freeReverseCSR(reverse);
+            freeCSR(csr);
+            if (graph)
+                freeGraph(graph);
+            return 1;
+        }
+        int C = index->C, intervalles = index->intervals;
 
-    float distBF[graph->V];
-    int pred[graph->V];
+        unsigned int etat = 515 + t;
+        int accessibles = 0;
+        t0 = chronometre();
+        for (int q = 0; q < nbRequetes; q++)
+            accessibles += isAccessibleIndexed(index, aleatoireSuivant(&etat) % V, aleatoireSuivant(&etat) % V);
+        double tIndex = chronometre() - t0;
 
-    bellmanFord(graph, src, distBF, pred, maxTime);
-    printBellmanFord(graph, src, distBF, pred);
+        etat = 515 + t;
+        int differences = 0;
+        t0 = chronometre();
+        for (int q = 0; q < nbControles; q++)
+        {
+            int s = aleatoireSuivant(&etat) % V, d = aleatoireSuivant(&etat) % V;
+            differences += isAccessibleBidirectional(csr, reverse, query, s, d) != isAccessibleIndexed(index, s, d);
+        }
+        double tBidir = chronometre() - t0;
 
-    // >>>>>>>>>> GLOUTONNE <<<<<<<<<<<
-    Colis colis[MAX_COLIS];
-    Vehicule vehicules[MAX_VEHICULES];
-    Carte carte;
-    int nbColis, nbVehicules;
+        // Insertions de routes : l'index est tenu à jour, puis comparé au graphe modifié
+        EdgeAttr attr = {10.0f, 10.0f, 1000.0f, 0, 1.0f, 0, 0};
+        t0 = chronometre();
+        for (int i = 0; i < nbInsertions; i++)
+            addEdgeIndexed(graph, index, aleatoireSuivant(&etat) % V, aleatoireSuivant(&etat) % V, attr);
+        double tInsert = (chronometre() - t0) / nbInsertions;
 
-    initialiserCarte(&carte);
-    chargerColis(colis, &nbColis);
-    chargerVehicules(vehicules, &nbVehicules);
+        CSRGraph *modifie = buildCSR(graph);
+        ReverseCSR *inverse = modifie ? buildReverseCSR(modifie) : NULL;
+        for (int q = 0; inverse && q < nbControles; q++)
+        {
+            int s = aleatoireSuivant(&etat) % V, d = aleatoireSuivant(&etat) % V;
+            differences += isAccessibleBidirectional(modifie, inverse, query, s, d) != isAccessibleIndexed(index, s, d);
+        }
 
-    affecterColis(vehicules, nbVehicules, colis, nbColis, &carte, graph);
-    afficherTournees(vehicules, nbVehicules, graph);
+        printf("%9d %9d %8d %10d %9.1f ms %12.0f %12.0f %10.1f us %8d\n", E, V, C, intervalles, tBuild * 1e3,
+               nbRequetes / tIndex, nbControles / tBidir, tInsert * 1e6, differences);
+        (void)accessibles;
 
+        freeReverseCSR(inverse);
+        freeCSR(modifie);
+        freeReachabilityIndex(index);
+        freeReachQuery(query);
+        freeReverseCSR(reverse);
+        freeCSR(csr);
+        freeGraph(graph);
+    }
     return 0;
 }
 
-// Fonction pour créer un graphe
-Graph *createGraph(int V)
+// Table des benchmarks disponibles
+typedef struct Benchmark
 {
-    Graph *graph = (Graph *)malloc(sizeof(Graph));
-    if (!graph)
+    const char *nom;
+    int (*lancer)(int argc, char *argv[]);
+    const char *description;
+} Benchmark;
+
+static bool benchmarkCompterVisite(void *context, int v, int parent)
+{
+    (void)v;
+    (void)parent;
+    (*(int *)context)++;
+    return true;
+}
+
+// Parcours en profondeur sur de longues chaînes (la version récursive dépassait la pile) :
+// parcours complet, tri topologique de la chaîne, CFC de la chaîne refermée en circuit
+static int benchmarkDFS(int argc, char *argv[])
+{
+    int defaults[] = {100000, 1000000, 3000000};
+    int nbTailles = argc > 0 ? argc : 3;
+
+    printf("%10s %11s %10s %12s %12s %12s %6s %10s\n", "sommets", "profondeur", "DFS", "tri topo", "cycles", "CFC",
+           "#CFC", "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        printf("Erreur : allocation mémoire échouée pour le graphe.\n");
-        return NULL;
+        int N = argc > 0 ? atoi(argv[t]) : defaults[t];
+        if (N < 2)
+            N = 2;
+        Graph *chaine = genererChaineRoutiere(N, false, 4242 + t);
+        CSRGraph *csr = chaine ? buildCSR(chaine) : NULL;
+        if (chaine)
+            freeGraph(chaine);
+        Graph *circuit = csr ? genererChaineRoutiere(N, true, 4242 + t) : NULL;
+        CSRGraph *boucle = circuit ? buildCSR(circuit) : NULL;
+        if (circuit)
+            freeGraph(circuit);
+        DFSEngine *engine = boucle ? createDFSEngine(N) : NULL;
+        int *order = malloc(N * sizeof(int));
+        int *position = malloc(N * sizeof(int));
+        int *component = malloc(N * sizeof(int));
+        if (!engine || !order || !position || !component)
+        {
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            free(order);
+            free(position);
+            free(component);
+            freeDFSEngine(engine);
+            freeCSR(boucle);
+            freeCSR(csr);
+            return 1;
+        }
+
+        int visites = 0;
+        DFSVisitor visitor = {benchmarkCompterVisite, NULL, NULL, &visites};
+        double t0 = chronometre();
+        dfsEngineRun(engine, csr, 0, &visitor);
+        double tDFS = chronometre() - t0;
+        int differences = visites != N;
+
+        t0 = chronometre();
+        bool acyclique = topologicalOrderCSR(csr, order);
+        double tTopo = chronometre() - t0;
+        for (int i = 0; i < N; i++)
+            position[order[i]] = i;
+        for (int u = 0; acyclique && u < N; u++)
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+                differences += position[u] >= position[csr->dest[e]];
+        differences += !acyclique + topologicalOrderCSR(boucle, order);
+
+        t0 = chronometre();
+        bool cycle = detectCyclesCSR(boucle, CYCLE_DIRECTED);
+        double tCycles = chronometre() - t0;
+        differences += !cycle;
+
+        t0 = chronometre();
+        int C = tarjanSCC(boucle, component);
+        double tSCC = chronometre() - t0;
+        differences += C != 1;
+
+        printf("%10d %11d %9.1fms %10.1fms %10.1fms %10.1fms %6d %10d\n", N, engine->maxDepth, tDFS * 1000,
+               tTopo * 1000, tCycles * 1000, tSCC * 1000, C, differences);
+
+        free(order);
+        free(position);
+        free(component);
+        freeDFSEngine(engine);
+        freeCSR(boucle);
+        freeCSR(csr);
     }
+    return 0;
+}
 
-    graph->V = V;
-    graph->array = (AdjList *)malloc(V * sizeof(AdjList));
-    graph->cityNames = (char **)malloc(V * sizeof(char *));
-    if (!graph->array || !graph->cityNames)
-    {
-        printf("Erreur : allocation mémoire échouée pour les structures internes.\n");
-        free(graph->array);
-        free(graph->cityNames);
-        free(graph);
+// Graphe acyclique aléatoire (chaque arc va d'un petit vers un grand numéro) dans lequel on
+// injecte nbRetours arcs arrière : chacun suit une marche aléatoire depuis w puis revient sur
+// w, si bien qu'il referme toujours un circuit
+static CSRGraph *benchmarkGrapheCircuits(int V, int E, int nbRetours, unsigned int seed)
+{
+    Graph *graph = createGraph(V);
+    if (!graph)
         return NULL;
-    }
 
+    unsigned int etat = seed ? seed : 1;
+    char name[32];
     for (int i = 0; i < V; i++)
     {
-        graph->array[i].head = NULL;
-        graph->cityNames[i] = NULL; // Initialiser à NULL
+        snprintf(name, sizeof(name), "V%d", i);
+        graph->cityNames[i] = strdup(name);
     }
 
-    return graph;
-}
-
-// Fonction pour ajouter une arête au graphe
-void addEdge(Graph *graph, int src, int dest, EdgeAttr attr)
-{
-    if (src < 0 || src >= graph->V || dest < 0 || dest >= graph->V)
+    EdgeAttr attr = {0};
+    attr.distance = 1.0f;
+    for (int i = 0; i < E; i++)
     {
-        printf("Erreur : arête invalide (%d -> %d).\n", src, dest);
-        return;
+        int a = aleatoireSuivant(&etat) % V, b = aleatoireSuivant(&etat) % V;
+        if (a != b)
+            addEdge(graph, a < b ? a : b, a < b ? b : a, attr);
     }
-
-    AdjListNode *newNode = (AdjListNode *)malloc(sizeof(AdjListNode));
-    if (!newNode)
+    for (int r = 0; r < nbRetours; r++)
     {
-        printf("Erreur : allocation mémoire échouée pour un nœud d'adjacence.\n");
-        return;
+        int w = aleatoireSuivant(&etat) % V, u = w;
+        for (int pas = 0; pas < 20 && graph->array[u].head; pas++)
+            u = graph->array[u].head->dest;
+        if (u != w)
+            addEdge(graph, u, w, attr);
     }
 
-    newNode->dest = dest;
-    newNode->attr = attr;
-    newNode->next = graph->array[src].head;
-    graph->array[src].head = newNode;
+    CSRGraph *csr = buildCSR(graph);
+    freeGraph(graph);
+    return csr;
 }
 
-// Fonction pour afficher le graphe
-void printGraph(Graph *graph)
+// Détection de circuits orientés sur des graphes d'un million d'arêtes : arrêt au premier
+// arc arrière, bilan complet (CFC cycliques) en une passe, règle non orientée pour comparaison
+static int benchmarkCycles(int argc, char *argv[])
 {
-    printf("--------------------------------------------------------\n");
-    printf("|\t\t\tGRAPHE DES VILLES\t\t\t|\n");
-    printf("--------------------------------------------------------\n\n");
+    int defaults[] = {100000, 1000000};
+    int nbTailles = argc > 0 ? argc : 2;
+    int retours[] = {0, 1, 100};
 
-    for (int i = 0; i < graph->V; i++)
+    printf("%9s %8s %10s %10s %12s %10s %10s %10s %12s %8s\n", "aretes", "retours", "orienté", "détection",
+           "bilan", "CFC cycl.", "villes", "circuit", "non orienté", "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        printf("Ville de depart : %s\n", graph->cityNames[i] ? graph->cityNames[i] : "Inconnue");
-        AdjListNode *pCrawl = graph->array[i].head;
-
-        if (pCrawl == NULL)
-        {
-            printf("   Aucune destination disponible depuis cette ville.\n");
-        }
-        else
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        int V = E / 4 > 2 ? E / 4 : 3;
+        for (int r = 0; r < 3; r++)
         {
-            printf("   Destinations:\n");
-            while (pCrawl)
+            CSRGraph *csr = benchmarkGrapheCircuits(V, E, retours[r], 8080 + t);
+            int *order = csr ? malloc(V * sizeof(int)) : NULL;
+            if (!order)
             {
-                printf("   -> %s (Distance: %.2f km, Cost: %.2f XOF)\n",
-                       graph->cityNames[pCrawl->dest] ? graph->cityNames[pCrawl->dest] : "Inconnue",
-                       pCrawl->attr.distance, pCrawl->attr.cost);
-                pCrawl = pCrawl->next;
+                printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+                freeCSR(csr);
+                return 1;
+            }
+
+            double t0 = chronometre();
+            bool oriente = detectCyclesCSR(csr, CYCLE_DIRECTED);
+            double tDetection = chronometre() - t0;
+
+            t0 = chronometre();
+            CycleReport *report = findCyclesCSR(csr);
+            double tBilan = chronometre() - t0;
+            if (!report)
+            {
+                free(order);
+                freeCSR(csr);
+                return 1;
+            }
+
+            bool nonOriente = detectCyclesCSR(csr, CYCLE_UNDIRECTED);
+
+            // Contrôles : détection, bilan et tri topologique doivent concorder, et le circuit
+            // exemple doit être fait d'arcs existants
+            int differences = (oriente != (report->components > 0)) + (oriente == topologicalOrderCSR(csr, order));
+            differences += oriente != (report->cycleLength > 0);
+            for (int i = 0; i < report->cycleLength; i++)
+            {
+                int u = report->cycle[i], v = report->cycle[(i + 1) % report->cycleLength];
+                bool arc = false;
+                for (int e = csr->offsets[u]; e < csr->offsets[u + 1] && !arc; e++)
+                    arc = csr->dest[e] == v;
+                differences += !arc;
             }
+
+            printf("%9d %8d %10s %8.1fms %10.1fms %10d %10d %10d %12s %8d\n", csr->E, retours[r], oriente ? "OUI" : "NON",
+                   tDetection * 1000, tBilan * 1000, report->components, report->members, report->cycleLength,
+                   nonOriente ? "OUI" : "NON", differences);
+
+            freeCycleReport(report);
+            free(order);
+            freeCSR(csr);
         }
-        printf("\n");
     }
-    printf("--------------------------------------------------------\n");
+    return 0;
 }
 
-// Fonction pour libérer la mémoire allouée au graphe
-void freeGraph(Graph *graph)
+// Niveaux par un BFS classique (tableau de booléens, file d'entiers), pour comparaison
+static void benchmarkNiveauxSimple(const CSRGraph *csr, int src, int *level, bool *visited, int *queue)
 {
-    for (int i = 0; i < graph->V; i++)
+    for (int v = 0; v < csr->V; v++)
     {
-        AdjListNode *pCrawl = graph->array[i].head;
-        while (pCrawl)
+        level[v] = -1;
+        visited[v] = false;
+    }
+    int front = 0, rear = 0;
+    visited[src] = true;
+    level[src] = 0;
+    queue[rear++] = src;
+    while (front < rear)
+    {
+        int u = queue[front++];
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
         {
-            AdjListNode *temp = pCrawl;
-            pCrawl = pCrawl->next;
-            free(temp); // Libère chaque nœud
+            int v = csr->dest[e];
+            if (!visited[v])
+            {
+                visited[v] = true;
+                level[v] = level[u] + 1;
+                queue[rear++] = v;
+            }
         }
-        free(graph->cityNames[i]); // Libère chaque nom de ville
     }
-    free(graph->cityNames);
-    free(graph->array); // Libère le tableau de listes
-    free(graph);        // Libère la structure du graphe
 }
 
-/**
- * - **Pile implicite (DFS)** :
- *   L'algorithme DFS utilise une pile implicite via l'appel récursif de la fonction `dfsUtil`.
- *   Ce choix est justifié par la simplicité et la lisibilité du code, car la pile d'exécution
- *   du programme gère automatiquement les appels récursifs. Cependant, cette approche peut
- *   entraîner un dépassement de pile (stack overflow) pour des graphes très grands ou très profonds.
- *
- * - **File explicite (BFS)** :
- *   L'algorithme BFS utilise une file explicite implémentée à l'aide d'un tableau dynamique
- *   (int *queue) et de deux indices (`front` et `rear`) pour gérer les opérations d'enfilement
- *   et de défilement. Ce choix est justifié par la nécessité de traiter les sommets dans l'ordre
- *   dans lequel ils sont découverts, ce qui est une caractéristique clé du BFS. L'utilisation
- *   d'un tableau dynamique permet une gestion simple et efficace de la file.
- *
- * @note Les structures auxiliaires (pile implicite et file explicite) sont adaptées aux besoins
- * spécifiques des algorithmes DFS et BFS respectivement, garantissant une implémentation efficace
- * et conforme aux principes de ces parcours.
- */
+// BFS à direction optimisée comparé au BFS classique, sur un graphe aléatoire (petit
+// diamètre) et sur une grille routière (grand diamètre), niveaux et parents vérifiés
+static int benchmarkBFS(int argc, char *argv[])
+{
+    int defaults[] = {1000000, 8000000};
+    int nbTailles = argc > 0 ? argc : 2;
+    const int nbSources = 5;
+
+    printf("%10s %9s %9s %8s %11s %13s %11s %9s %9s %8s\n", "graphe", "aretes", "sommets", "niveaux", "classique",
+           "descendant", "optimisé", "speedup", "montants", "écarts");
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        for (int g = 0; g < 2; g++)
+        {
+            Graph *graph;
+            if (g == 0)
+                graph = genererGrapheAleatoire(E / 8 > 1 ? E / 8 : 2, E, 6060 + t);
+            else
+            {
+                int cote = 2;
+                while ((long long)2 * cote * cote < E)
+                    cote++;
+                graph = genererGrilleRoutiere(cote, cote, 6060 + t);
+            }
+            CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+            if (graph)
+                freeGraph(graph);
+            ReverseCSR *reverse = csr ? buildReverseCSR(csr) : NULL;
+            BFSTree *tree = reverse ? createBFSTree(csr->V) : NULL;
+            int V = csr ? csr->V : 0;
+            int *level = malloc((V > 0 ? V : 1) * sizeof(int));
+            int *queue = malloc((V > 0 ? V : 1) * sizeof(int));
+            bool *visited = malloc((V > 0 ? V : 1) * sizeof(bool));
+            if (!tree || !level || !queue || !visited)
+            {
+                printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+                free(level);
+                free(queue);
+                free(visited);
+                freeBFSTree(tree);
+                freeReverseCSR(reverse);
+                freeCSR(csr);
+                return 1;
+            }
+
+            double tSimple = 0, tDescendant = 0, tOptimise = 0;
+            int differences = 0, montants = 0, niveaux = 0;
+            unsigned int etat = 77 + t;
+            for (int q = 0; q < nbSources; q++)
+            {
+                int src = aleatoireSuivant(&etat) % V;
+                double t0 = chronometre();
+                benchmarkNiveauxSimple(csr, src, level, visited, queue);
+                tSimple += chronometre() - t0;
+
+                t0 = chronometre();
+                bfsDirectionOptimizing(csr, NULL, tree, src);
+                tDescendant += chronometre() - t0;
+
+                t0 = chronometre();
+                bfsDirectionOptimizing(csr, reverse, tree, src);
+                tOptimise += chronometre() - t0;
+                montants += tree->bottomUpSteps;
+                if (tree->depth > niveaux)
+                    niveaux = tree->depth;
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// >>> DFS ALGORITHM
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// Fonction pour effectuer un parcours en profondeur (DFS) à partir d'un sommet donné
-void dfsUtil(Graph *graph, int v, bool *visited)
-{
-    // Marquer le sommet actuel comme visité
-    visited[v] = true;
-    printf("%s ", graph->cityNames[v]);
+                // Mêmes niveaux, et chaque parent est un prédécesseur direct au niveau précédent
+                for (int v = 0; v < V; v++)
+                {
+                    differences += tree->level[v] != level[v];
+                    int p = tree->parent[v];
+                    if (p >= 0)
+                    {
+                        bool arc = false;
+                        for (int e = csr->offsets[p]; e < csr->offsets[p + 1] && !arc; e++)
+                            arc = csr->dest[e] == v;
+                        differences += !arc || level[p] != level[v] - 1;
+                    }
+                    else
+                        differences += v != src && level[v] >= 0;
+                }
+            }
 
-    // Parcourir tous les voisins du sommet actuel
-    AdjListNode *node = graph->array[v].head;
-    while (node)
-    {
-        if (!visited[node->dest])
-        {
-            dfsUtil(graph, node->dest, visited);
+            printf("%10s %9d %9d %8d %9.1fms %11.1fms %9.1fms %8.1fx %9d %8d\n", g == 0 ? "aléatoire" : "grille", csr->E,
+                   V, niveaux, tSimple * 1000 / nbSources, tDescendant * 1000 / nbSources, tOptimise * 1000 / nbSources,
+                   tSimple / tOptimise, montants, differences);
+
+            free(level);
+            free(queue);
+            free(visited);
+            freeBFSTree(tree);
+            freeReverseCSR(reverse);
+            freeCSR(csr);
         }
-        node = node->next;
     }
+    return 0;
 }
 
-// Fonction principale pour effectuer un DFS sur tout le graphe
-void dfs(Graph *graph, int startVertex)
+// Réseau symétrisé (arcs sortants et entrants de chaque sommet) réduit à sa structure :
+// seuls offsets et dest sont remplis, assez pour labelConnectedComponentsCSR
+static CSRGraph *benchmarkSymetrise(const CSRGraph *csr, const ReverseCSR *reverse)
 {
-    // Tableau pour suivre les sommets visités
-    bool *visited = (bool *)malloc(graph->V * sizeof(bool));
-    for (int i = 0; i < graph->V; i++)
+    CSRGraph *sym = (CSRGraph *)calloc(1, sizeof(CSRGraph));
+    if (!sym)
+        return NULL;
+    sym->V = csr->V;
+    sym->E = 2 * csr->E;
+    sym->offsets = (int *)malloc((csr->V + 1) * sizeof(int));
+    sym->dest = (int *)malloc((sym->E > 0 ? sym->E : 1) * sizeof(int));
+    if (!sym->offsets || !sym->dest)
     {
-        visited[i] = false;
+        freeCSR(sym);
+        return NULL;
     }
-
-    printf("Parcours en profondeur (DFS) à partir de %s :\n", graph->cityNames[startVertex]);
-    dfsUtil(graph, startVertex, visited);
-
-    printf("\n");
-
-    // Libérer la mémoire
-    free(visited);
+    int k = 0;
+    for (int u = 0; u < csr->V; u++)
+    {
+        sym->offsets[u] = k;
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+            sym->dest[k++] = csr->dest[e];
+        for (int e = reverse->offsets[u]; e < reverse->offsets[u + 1]; e++)
+            sym->dest[k++] = reverse->source[e];
+    }
+    sym->offsets[csr->V] = k;
+    return sym;
 }
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// >>> BFS ALGORITHM
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// Fonction pour effectuer un parcours en largeur (BFS) à partir d'un sommet donné
-void bfs(Graph *graph, int startVertex)
+// Composantes faiblement connexes : parcours en largeur de findConnectedComponentsCSR
+// (labelConnectedComponentsCSR) sur le réseau symétrisé comparé à l'union-find parallèle
+// (1 thread puis tous les cœurs), étiquettes comparées sommet par sommet
+static int benchmarkComposantes(int argc, char *argv[])
 {
-    // Créer un tableau pour suivre les sommets visités
-    bool *visited = (bool *)malloc(graph->V * sizeof(bool));
-    for (int i = 0; i < graph->V; i++)
-        visited[i] = false;
-
-    // Créer une file pour le BFS
-    int *queue = (int *)malloc(graph->V * sizeof(int));
-    int front = 0, rear = 0;
-
-    // Marquer le sommet de départ comme visité et l'ajouter à la file
-    visited[startVertex] = true;
-    queue[rear++] = startVertex;
-
-    printf("Parcours en largeur (BFS) à partir de %s :\n", graph->cityNames[startVertex]);
+    int defaults[] = {1000000, 8000000};
+    int nbTailles = argc > 0 ? argc : 2;
+    int nbThreads = nombreThreadsMax();
 
-    while (front < rear)
+    printf("%10s %9s %9s %11s %11s %9s %11s %11s %9s %8s\n", "graphe", "aretes", "sommets", "composantes",
+           "plus grande", "BFS", "UF 1 thr.", "UF N thr.", "speedup", "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        // Extraire un sommet de la file
-        int currentVertex = queue[front++];
-        printf("%s ", graph->cityNames[currentVertex]);
-
-        // Parcourir tous les voisins du sommet actuel
-        AdjListNode *node = graph->array[currentVertex].head;
-        while (node)
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        for (int g = 0; g < 2; g++)
         {
-            if (!visited[node->dest])
+            Graph *graph;
+            if (g == 0)
+                graph = genererGrapheAleatoire(E > 1 ? E : 2, E, 9191 + t); // degré moyen 1 : beaucoup de composantes
+            else
             {
-                visited[node->dest] = true;
-                queue[rear++] = node->dest;
+                int cote = 2;
+                while ((long long)2 * cote * cote < E)
+                    cote++;
+                graph = genererGrilleRoutiere(cote, cote, 9191 + t);
+            }
+            CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+            if (graph)
+                freeGraph(graph);
+            ReverseCSR *reverse = csr ? buildReverseCSR(csr) : NULL;
+            CSRGraph *sym = reverse ? benchmarkSymetrise(csr, reverse) : NULL;
+            int V = csr ? csr->V : 0;
+            int *label = malloc((V > 0 ? V : 1) * sizeof(int));
+            int *queue = malloc((V > 0 ? V : 1) * sizeof(int));
+            if (!sym || !label || !queue)
+            {
+                printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+                free(label);
+                free(queue);
+                freeCSR(sym);
+                freeReverseCSR(reverse);
+                freeCSR(csr);
+                return 1;
             }
-            node = node->next;
-        }
-    }
 
-    printf("\n");
+            double t0 = chronometre();
+            int count = labelConnectedComponentsCSR(sym, label, queue);
+            double tBFS = chronometre() - t0;
+            freeCSR(sym);
 
-    // Libérer la mémoire
-    free(visited);
-    free(queue);
+            t0 = chronometre();
+            ComponentLabels *seq = connectedComponentsUnionFind(csr, reverse, 1);
+            double tSeq = chronometre() - t0;
+            t0 = chronometre();
+            ComponentLabels *par = connectedComponentsUnionFind(csr, reverse, nbThreads);
+            double tPar = chronometre() - t0;
+            if (!seq || !par)
+            {
+                freeComponentLabels(seq);
+                freeComponentLabels(par);
+                free(label);
+                free(queue);
+                freeReverseCSR(reverse);
+                freeCSR(csr);
+                return 1;
+            }
+
+            int differences = (seq->count != count) + (par->count != count);
+            int plusGrande = 0;
+            for (int v = 0; v < V; v++)
+                differences += (seq->label[v] != label[v]) + (par->label[v] != label[v]);
+            for (int c = 0; c < par->count; c++)
+                if (par->size[c] > plusGrande)
+                    plusGrande = par->size[c];
+
+            printf("%10s %9d %9d %11d %11d %7.1fms %9.1fms %9.1fms %8.1fx %8d\n", g == 0 ? "aléatoire" : "grille", csr->E,
+                   V, count, plusGrande, tBFS * 1000, tSeq * 1000, tPar * 1000, tBFS / tPar, differences);
+
+            freeComponentLabels(seq);
+            freeComponentLabels(par);
+            free(label);
+            free(queue);
+            freeReverseCSR(reverse);
+            freeCSR(csr);
+        }
+    }
+    return 0;
 }
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// >>> FLOYD-WARSHALL ALGORITHM
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// Fonction pour trouver le chemin le plus court entre tous les paires de sommets
-void floydWarshall(Graph *graph, float dist[][graph->V])
+// Statistiques du réseau : passe sur les arcs seule puis avec estimation du diamètre,
+// résultats contrôlés par un recomptage séquentiel
+static int benchmarkStats(int argc, char *argv[])
 {
-    int V = graph->V;
+    int defaults[] = {1000000, 8000000};
+    int nbTailles = argc > 0 ? argc : 2;
 
-    // Initialisation
-    for (int i = 0; i < V; i++)
+    printf("%9s %9s %10s %12s %12s %10s %8s\n", "aretes", "sommets", "passe", "+ diamètre", "+ inverse", "diamètre",
+           "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        for (int j = 0; j < V; j++)
+        int E = argc > 0 ? atoi(argv[t]) : defaults[t];
+        int V = E / 4 > 1 ? E / 4 : 2;
+        Graph *graph = genererGrapheAleatoire(V, E, 5353 + t);
+        CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+        if (graph)
+            freeGraph(graph);
+        ReverseCSR *reverse = csr ? buildReverseCSR(csr) : NULL;
+        if (!reverse)
         {
-            dist[i][j] = (i == j) ? 0 : INF;
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            freeCSR(csr);
+            return 1;
         }
 
-        AdjListNode *pCrawl = graph->array[i].head;
-        while (pCrawl)
+        GraphStats passe, complet, inverse;
+        bool ok = calculateConnectivityStatsCSR(csr, NULL, 0, &passe) &&
+                  calculateConnectivityStatsCSR(csr, NULL, STATS_BFS_SAMPLES, &complet) &&
+                  calculateConnectivityStatsCSR(csr, reverse, STATS_BFS_SAMPLES, &inverse);
+        if (!ok)
         {
-            dist[i][pCrawl->dest] = pCrawl->attr.distance; // ou baseTime / cost selon le critère
-            pCrawl = pCrawl->next;
+            freeReverseCSR(reverse);
+            freeCSR(csr);
+            return 1;
         }
-    }
 
-    // Algorithme de Floyd-Warshall
-    for (int k = 0; k < V; k++)
-    {
-        for (int i = 0; i < V; i++)
+        // Recomptage séquentiel de quelques totaux
+        int differences = 0, sortants = 0, entrants = 0, types = 0, peages = 0;
+        float minDistance = FLT_MAX, maxCost = -FLT_MAX;
+        for (int i = 0; i < STATS_DEGREE_BUCKETS; i++)
         {
-            for (int j = 0; j < V; j++)
-            {
-                if (dist[i][k] + dist[k][j] < dist[i][j])
-                    dist[i][j] = dist[i][k] + dist[k][j];
-            }
+            sortants += passe.outDegreeHistogram[i];
+            entrants += passe.inDegreeHistogram[i];
+        }
+        for (int i = 0; i < STATS_ROAD_TYPES; i++)
+            types += passe.roadTypes[i];
+        for (int e = 0; e < csr->E; e++)
+        {
+            minDistance = csr->distance[e] < minDistance ? csr->distance[e] : minDistance;
+            maxCost = csr->cost[e] > maxCost ? csr->cost[e] : maxCost;
+            peages += csr->toll[e] > 0;
         }
+        differences += (sortants != V) + (entrants != V) + (types != csr->E) + (peages != passe.tollEdges);
+        differences += (minDistance != passe.distance.min) + (maxCost != passe.cost.max);
+        differences += (inverse.maxInDegree != passe.maxInDegree) + (inverse.minInDegree != passe.minInDegree);
+        differences += inverse.diameter != complet.diameter;
+
+        printf("%9d %9d %8.1fms %10.1fms %10.1fms %10d %8d\n", csr->E, V, passe.seconds * 1000, complet.seconds * 1000,
+               inverse.seconds * 1000, complet.diameter, differences);
+
+        freeReverseCSR(reverse);
+        freeCSR(csr);
     }
+    return 0;
 }
 
-// Fonction pour afficher les distances
-void printFloydWarshall(Graph *graph, float dist[][graph->V])
+// Flotte et colis aléatoires sur une grille routière : véhicules de 500 à 1500 kg et de 100
+// à 300 en volume répartis sur les villes, colis de 1 à 50 kg et de 1 à 10 en volume vers
+// des destinations tirées au hasard, pourcentUrgents % d'entre eux urgents
+static bool benchmarkFlotte(int V, Flotte *flotte, int nbVehicules, LotColis *colis, int nbColis, int pourcentUrgents,
+                            unsigned int seed)
 {
-    printf("\n===== Plus courts chemins entre toutes les paires de villes (en km) - FLOYD WARSHALL =====\n");
-
-    for (int i = 0; i < graph->V; i++)
+    unsigned int etat = seed;
+    for (int j = 0; j < nbVehicules; j++)
     {
-        for (int j = 0; j < graph->V; j++)
-        {
-            printf("De %-15s à %-15s : ", graph->cityNames[i], graph->cityNames[j]);
-            if (dist[i][j] == INF)
-                printf("Aucun chemin\n");
-            else
-                printf("%.2f km\n", dist[i][j]);
-        }
-        printf("\n");
+        float capaciteMax[CAPACITE_DIMENSIONS];
+        capaciteMax[DIM_POIDS] = (float)(500 + aleatoireSuivant(&etat) % 1001);
+        capaciteMax[DIM_VOLUME] = (float)(100 + aleatoireSuivant(&etat) % 201);
+        if (ajouterVehicule(flotte, capaciteMax, (int)(aleatoireSuivant(&etat) % V)) < 0)
+            return false;
+    }
+    for (int i = 0; i < nbColis; i++)
+    {
+        int villeDest = (int)(aleatoireSuivant(&etat) % V);
+        float charge[CAPACITE_DIMENSIONS];
+        charge[DIM_POIDS] = (float)(1 + aleatoireSuivant(&etat) % 50);
+        charge[DIM_VOLUME] = (float)(1 + aleatoireSuivant(&etat) % 10);
+        int urgent = pourcentUrgents > 0 && (int)(aleatoireSuivant(&etat) % 100) < pourcentUrgents;
+        if (ajouterColis(colis, villeDest, charge, urgent) < 0)
+            return false;
     }
+    return true;
 }
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// >>> BELLMAN-FORD ALGORITHM
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// Fonction pour trouver le chemin le plus court à partir d'une source
-void bellmanFord(Graph *graph, int src, float *dist, int *pred, float maxTime)
+// Affectation gloutonne : parcours complet de la flotte par colis (filtre SIMD des
+// véhicules compatibles, puis le plus proche) vs index par ville et par capacités. Le
+// contrôle rejoue l'affectation indexée et vérifie, colis par colis, que le véhicule
+// retenu est celui du parcours complet.
+// Usage : main --bench flotte [colis véhicules ...]   (par défaut 20000 500 200000 5000)
+static int benchmarkAffectation(int argc, char *argv[])
 {
-    int V = graph->V;
-    float time[V]; // Array to track cumulative time
+    int defaults[] = {20000, 500, 200000, 5000};
+    int nbTailles = argc > 1 ? argc / 2 : 2;
+    const int cote = 60, nbControles = 20000;
+    FWKernel kernel = floydWarshallResolveKernel(FW_KERNEL_AUTO);
 
-    // Initialisation
-    for (int i = 0; i < V; i++)
+    Graph *graph = genererGrilleRoutiere(cote, cote, 2222);
+    CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+    if (graph)
+        freeGraph(graph);
+    if (!csr)
     {
-        dist[i] = INF;
-        time[i] = INF;
-        pred[i] = -1;
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+        return 1;
     }
-    dist[src] = 0;
-    time[src] = 0;
 
-    // Relaxation des arêtes V-1 fois
-    for (int i = 1; i <= V - 1; i++)
+    printf("Grille %dx%d (%d villes)\n", cote, cote, csr->V);
+    printf("%9s %9s %12s %12s %9s %13s %8s %9s %10s %8s\n", "colis", "véhicules", "parcours", "index", "gain",
+           "affectés", "lignes", "mémoire", "contrôlés", "écarts");
+    for (int t = 0; t < nbTailles; t++)
     {
-        for (int u = 0; u < V; u++)
+        int nbColis = argc > 1 ? atoi(argv[2 * t]) : defaults[2 * t];
+        int nbVehicules = argc > 1 ? atoi(argv[2 * t + 1]) : defaults[2 * t + 1];
+        LotColis colis;
+        Flotte flotte;
+        Carte carte;
+        initialiserLotColis(&colis);
+        initialiserFlotte(&flotte);
+        int *affectation = malloc((nbColis > 0 ? nbColis : 1) * sizeof(int));
+        float *distance = malloc((nbColis > 0 ? nbColis : 1) * sizeof(float));
+        int *liste = malloc((nbVehicules > 0 ? nbVehicules : 1) * sizeof(int));
+        bool ok = affectation && distance && liste &&
+                  benchmarkFlotte(csr->V, &flotte, nbVehicules, &colis, nbColis, 0, 4242 + t);
+        if (!ok || !initialiserCarte(&carte, csr, METRIC_DISTANCE))
         {
-            AdjListNode *node = graph->array[u].head;
-            while (node)
-            {
-                int v = node->dest;
-
-                // float weight = node->attr.cost + 10 * node->attr.toll;
-                float weight = node->attr.cost;
-                float edgeTime = node->attr.baseTime;
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            libererLotColis(&colis);
+            libererFlotte(&flotte);
+            free(affectation);
+            free(distance);
+            free(liste);
+            freeCSR(csr);
+            return 1;
+        }
 
-                // Appliquer une contrainte sur le temps
-                if (time[u] + edgeTime <= maxTime && dist[u] + weight < dist[v])
-                {
-                    dist[v] = dist[u] + weight;
-                    time[v] = time[u] + edgeTime; // Update cumulative time
-                    pred[v] = u;
-                }
+        // Les lignes de Dijkstra sont calculées une fois pour toutes avant de chronométrer
+        for (int j = 0; j < nbVehicules; j++)
+            carteLigne(&carte, flotte.villeActuelle[j]);
 
-                node = node->next;
-            }
+        // Parcours complet de la flotte pour chaque colis
+        double t0 = chronometre();
+        int affectesLineaire = 0;
+        for (int i = 0; i < nbColis && ok; i++)
+        {
+            float d, charge[CAPACITE_DIMENSIONS];
+            chargeDuColis(&colis, i, charge);
+            int best = meilleurVehiculeParcours(&flotte, &carte, colis.villeDest[i], charge, AFFECTATION_PROCHE,
+                                                kernel, liste, &d);
+            if (best < 0)
+                continue;
+            for (int k = 0; k < CAPACITE_DIMENSIONS; k++)
+                flotte.capaciteRestante[k][best] -= charge[k];
+            ok = ajouterLivraison(&flotte, best, colis.villeDest[i]);
+            affectesLineaire++;
         }
-    }
+        double tLineaire = chronometre() - t0;
 
-    // Vérification des cycles négatifs (facultatif ici)
-    for (int u = 0; u < V; u++)
-    {
-        AdjListNode *node = graph->array[u].head;
-        while (node)
-        {
-            int v = node->dest;
-            // float weight = node->attr.cost + 10 * node->attr.toll;
-            float weight = node->attr.cost;
-            float edgeTime = node->attr.baseTime;
+        // Index par ville et par capacités
+        viderTournees(&flotte);
+        t0 = chronometre();
+        int affectes = affecterColisIndexe(&flotte, &colis, AFFECTATION_PROCHE, &carte, affectation, distance);
+        double tIndex = chronometre() - t0;
+        double memoire = (colis.arena.bytes + flotte.arena.bytes) / (1024.0 * 1024.0);
 
-            if (time[u] + edgeTime <= maxTime && dist[u] + weight < dist[v])
+        // Contrôle pas à pas sur les premiers colis
+        viderTournees(&flotte);
+        int controles = nbColis < nbControles ? nbColis : nbControles;
+        int differences = !ok || affectes < 0;
+        for (int i = 0; i < controles && affectes >= 0; i++)
+        {
+            float d, charge[CAPACITE_DIMENSIONS];
+            chargeDuColis(&colis, i, charge);
+            int best = meilleurVehiculeParcours(&flotte, &carte, colis.villeDest[i], charge, AFFECTATION_PROCHE,
+                                                kernel, liste, &d);
+            int j = affectation[i];
+            differences += best != j || (j >= 0 && d != distance[i]);
+            if (j >= 0)
             {
-                printf("Attention : présence d’un cycle de poids négatif.\n");
-                return;
+                for (int k = 0; k < CAPACITE_DIMENSIONS; k++)
+                {
+                    differences += flotte.capaciteRestante[k][j] < charge[k];
+                    flotte.capaciteRestante[k][j] -= charge[k];
+                }
+                ajouterLivraison(&flotte, j, colis.villeDest[i]);
             }
-
-            node = node->next;
         }
+
+        printf("%9d %9d %10.1fms %10.1fms %8.1fx %6d/%-6d %8d %7.1fMo %10d %8d\n", nbColis, nbVehicules,
+               tLineaire * 1000, tIndex * 1000, tLineaire / tIndex, affectes, affectesLineaire, carte.nbRows, memoire,
+               controles, differences);
+
+        libererCarte(&carte);
+        libererLotColis(&colis);
+        libererFlotte(&flotte);
+        free(affectation);
+        free(distance);
+        free(liste);
     }
+    freeCSR(csr);
+    return 0;
 }
 
-// Fonction pour afficher le chemin le plus court
-void printBellmanFord(Graph *graph, int src, float *dist, int *pred)
+// Capacités multiples : affectation sur le seul poids (règle d'origine, volume ignoré)
+// comparée aux modes proche et remplissage, qui respectent poids et volume. Pour chaque
+// mode : véhicules utilisés, distance moyenne par colis, charge des véhicules utilisés
+// rapportée à leur capacité (par dimension), surcharges (véhicules dont une dimension
+// dépasse la capacité). Le mode remplissage doit utiliser moins de véhicules que le mode
+// proche. Le contrôle rejoue les premiers colis par parcours complet de la flotte et
+// vérifie que le même véhicule est choisi. Le filtre des véhicules compatibles est enfin
+// chronométré sur toute la flotte, en C portable puis en AVX2. Par défaut, une flotte trop
+// petite pour tous les colis, puis une grande flotte qui a de la place en trop.
+// Usage : main --bench capacites [colis véhicules ...]   (par défaut 200000 5000 500000 50000)
+static int benchmarkCapacites(int argc, char *argv[])
 {
-    printf("\n===== Chemins optimaux depuis %s (BELLMAN-FORD) =====\n", graph->cityNames[src]);
+    int defaults[] = {200000, 5000, 500000, 50000};
+    int nbTailles = argc > 1 ? argc / 2 : 2;
+    const int cote = 60, nbControles = 2000, nbFiltres = 2000;
+    const char *nomsModes[] = {"poids seul", "proche", "remplissage"};
+    FWKernel kernel = floydWarshallResolveKernel(FW_KERNEL_AUTO);
 
-    for (int i = 0; i < graph->V; i++)
+    Graph *graph = genererGrilleRoutiere(cote, cote, 2222);
+    CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+    if (graph)
+        freeGraph(graph);
+    if (!csr)
     {
-        printf("Vers %-15s : ", graph->cityNames[i]);
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+        return 1;
+    }
 
-        if (dist[i] == INF)
+    printf("Grille %dx%d (%d villes)\n", cote, cote, csr->V);
+    for (int t = 0; t < nbTailles; t++)
+    {
+        int nbColis = argc > 1 ? atoi(argv[2 * t]) : defaults[2 * t];
+        int nbVehicules = argc > 1 ? atoi(argv[2 * t + 1]) : defaults[2 * t + 1];
+        LotColis colis, poidsSeul;
+        Flotte flotte;
+        Carte carte;
+        initialiserLotColis(&colis);
+        initialiserLotColis(&poidsSeul);
+        initialiserFlotte(&flotte);
+        int n = nbVehicules > 0 ? nbVehicules : 1;
+        int *affectation = malloc((nbColis > 0 ? nbColis : 1) * sizeof(int));
+        float *distance = malloc((nbColis > 0 ? nbColis : 1) * sizeof(float));
+        int *liste = malloc(n * sizeof(int));
+        float *chargeVehicule = malloc((size_t)n * CAPACITE_DIMENSIONS * sizeof(float));
+        bool ok = affectation && distance && liste && chargeVehicule &&
+                  benchmarkFlotte(csr->V, &flotte, nbVehicules, &colis, nbColis, 0, 4242 + t);
+        // Même lot sans volume : la règle d'origine ne regarde que le poids
+        for (int i = 0; i < colis.count && ok; i++)
         {
-            printf("Aucun chemin respectant les contraintes.\n");
+            float charge[CAPACITE_DIMENSIONS] = {0};
+            charge[DIM_POIDS] = colis.charge[DIM_POIDS][i];
+            ok = ajouterColis(&poidsSeul, colis.villeDest[i], charge, 0) >= 0;
         }
-        else
+        if (!ok || !initialiserCarte(&carte, csr, METRIC_DISTANCE))
         {
-            float totalTime = 0;
-            float totalCost = 0;
-            int path[graph->V];
-            int count = 0;
+            printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+            libererLotColis(&colis);
+            libererLotColis(&poidsSeul);
+            libererFlotte(&flotte);
+            free(affectation);
+            free(distance);
+            free(liste);
+            free(chargeVehicule);
+            freeCSR(csr);
+            return 1;
+        }
+        for (int j = 0; j < nbVehicules; j++)
+            carteLigne(&carte, flotte.villeActuelle[j]);
 
-            for (int v = i; v != -1; v = pred[v])
-                path[count++] = v;
+        printf("\n%d colis, %d véhicules\n", nbColis, nbVehicules);
+        printf("%-12s %10s %9s %9s %9s %8s %8s %10s %10s %8s\n", "mode", "temps", "affectés", "utilisés", "km/colis",
+               "poids", "volume", "surcharges", "contrôlés", "écarts");
+        for (int m = 0; m < 3; m++)
+        {
+            ModeAffectation mode = m == 2 ? AFFECTATION_REMPLISSAGE : AFFECTATION_PROCHE;
+            const LotColis *lot = m == 0 ? &poidsSeul : &colis;
+            viderTournees(&flotte);
+            double t0 = chronometre();
+            int affectes = affecterColisIndexe(&flotte, lot, mode, &carte, affectation, distance);
+            double temps = chronometre() - t0;
 
-            for (int j = count - 1; j > 0; j--)
+            // Charges réelles (volume compris) des véhicules utilisés
+            memset(chargeVehicule, 0, (size_t)n * CAPACITE_DIMENSIONS * sizeof(float));
+            for (int i = 0; i < nbColis && affectes >= 0; i++)
+                if (affectation[i] >= 0)
+                    for (int k = 0; k < CAPACITE_DIMENSIONS; k++)
+                        chargeVehicule[(size_t)affectation[i] * CAPACITE_DIMENSIONS + k] += colis.charge[k][i];
+            double charge[CAPACITE_DIMENSIONS] = {0}, capacite[CAPACITE_DIMENSIONS] = {0}, km = 0;
+            int surcharges = 0, utilises = 0;
+            for (int i = 0; i < nbColis && affectes >= 0; i++)
+                if (affectation[i] >= 0)
+                    km += distance[i];
+            for (int j = 0; j < nbVehicules; j++)
             {
-                AdjListNode *node = graph->array[path[j]].head;
-                while (node && node->dest != path[j - 1])
-                    node = node->next;
+                if (flotte.nbLivraisons[j] == 0)
+                    continue;
+                utilises++;
+                bool depasse = false;
+                for (int k = 0; k < CAPACITE_DIMENSIONS; k++)
+                {
+                    float c = chargeVehicule[(size_t)j * CAPACITE_DIMENSIONS + k];
+                    charge[k] += c;
+                    capacite[k] += flotte.capaciteMax[k][j];
+                    depasse |= c > flotte.capaciteMax[k][j];
+                }
+                surcharges += depasse;
+            }
 
-                if (node)
+            // Contrôle : même score que le meilleur véhicule du parcours complet
+            viderTournees(&flotte);
+            int controles = nbColis < nbControles ? nbColis : nbControles;
+            int differences = affectes < 0;
+            for (int i = 0; i < controles && affectes >= 0; i++)
+            {
+                float d, c[CAPACITE_DIMENSIONS];
+                chargeDuColis(lot, i, c);
+                int best = meilleurVehiculeParcours(&flotte, &carte, lot->villeDest[i], c, mode, kernel, liste, &d);
+                int j = affectation[i];
+                differences += best != j || (j >= 0 && d != distance[i]);
+                if (j < 0)
+                    continue;
+                for (int k = 0; k < CAPACITE_DIMENSIONS; k++)
                 {
-                    totalTime += node->attr.baseTime;
-                    totalCost += node->attr.cost; // instead of node->attr.cost + 10 * node->attr.toll
+                    differences += flotte.capaciteRestante[k][j] < c[k];
+                    flotte.capaciteRestante[k][j] -= c[k];
                 }
+                ajouterLivraison(&flotte, j, lot->villeDest[i]);
             }
 
-            printf("Temps = %.2f, Cout = %.2f XOF, Chemin = ", totalTime, totalCost);
-            for (int j = count - 1; j >= 0; j--)
+            printf("%-12s %8.1fms %9d %9d %9.1f %7.1f%% %7.1f%% %10d %10d %8d\n", nomsModes[m], temps * 1000, affectes,
+                   utilises, affectes > 0 ? km / affectes : 0.0,
+                   capacite[DIM_POIDS] > 0 ? 100 * charge[DIM_POIDS] / capacite[DIM_POIDS] : 0.0,
+                   capacite[DIM_VOLUME] > 0 ? 100 * charge[DIM_VOLUME] / capacite[DIM_VOLUME] : 0.0, surcharges,
+                   controles, differences);
+        }
+
+        // Filtre des véhicules compatibles sur toute la flotte (flotte vide)
+        viderTournees(&flotte);
+        int filtres = nbColis < nbFiltres ? nbColis : nbFiltres;
+        double tFiltre[2];
+        long long trouves[2] = {0, 0};
+        FWKernel noyaux[2] = {FW_KERNEL_SCALAIRE, kernel};
+        for (int k = 0; k < 2; k++)
+        {
+            double t0 = chronometre();
+            for (int i = 0; i < filtres; i++)
             {
-                printf("%s", graph->cityNames[path[j]]);
-                if (j > 0)
-                    printf(" -> ");
+                float c[CAPACITE_DIMENSIONS];
+                chargeDuColis(&colis, i, c);
+                trouves[k] += vehiculesCompatibles(&flotte, c, liste, noyaux[k]);
             }
-            printf("\n");
+            tFiltre[k] = chronometre() - t0;
         }
+        double parSeconde = (double)filtres * nbVehicules / tFiltre[1] / 1e6;
+        printf("Filtre de la flotte (%d colis) : portable %.1fms, %s %.1fms (%.1fx, %.0f M véhicules/s)%s\n", filtres,
+               tFiltre[0] * 1000, floydWarshallKernelName(kernel), tFiltre[1] * 1000, tFiltre[0] / tFiltre[1],
+               parSeconde, trouves[0] == trouves[1] ? "" : " ÉCART");
+
+        libererCarte(&carte);
+        libererLotColis(&colis);
+        libererLotColis(&poidsSeul);
+        libererFlotte(&flotte);
+        free(affectation);
+        free(distance);
+        free(liste);
+        free(chargeVehicule);
     }
+    freeCSR(csr);
+    return 0;
 }
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// >>> GLOUTONNE ALGORITHM
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-// ---------- AFFECTATION GLOUTONNE ----------
-void affecterColis(Vehicule *vehicules, int nbVehicules, Colis *colis, int nbColis, Carte *carte, Graph *graph)
+static int compareClesDecroissantes(const void *a, const void *b)
 {
-    printf("\n===== Affectation des colis aux véhicules (GLOUTONNE) =====\n");
-    for (int i = 0; i < nbColis; i++)
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x < y) - (x > y);
+}
+
+// Ordre de traitement des colis sur une flotte trop petite : par numéro, puis urgents
+// d'abord (file de priorité). Pour chaque ordre : temps de la file et de l'affectation,
+// colis affectés, part des urgents affectés, distance moyenne. Puis flux de colis arrivant
+// par lots, dont la moitié la plus prioritaire est expédiée après chaque lot : insertion
+// dans le tas comparée au tri complet du reste à chaque lot (mêmes colis expédiés,
+// vérifiés un à un).
+// Usage : main --bench priorites [colis véhicules pourcentUrgents lots]   (par défaut 200000 5000 20 50)
+static int benchmarkPriorites(int argc, char *argv[])
+{
+    int nbColis = argc > 0 ? atoi(argv[0]) : 200000;
+    int nbVehicules = argc > 1 ? atoi(argv[1]) : 5000;
+    int pourcentUrgents = argc > 2 ? atoi(argv[2]) : 20;
+    int nbLots = argc > 3 ? atoi(argv[3]) : 50;
+    const int cote = 60;
+    const char *nomsOrdres[] = {"numéros", "urgents"};
+    if (nbColis < 1 || nbLots < 1)
+    {
+        printf("Erreur : paramètres invalides.\n");
+        return 1;
+    }
+
+    Graph *graph = genererGrilleRoutiere(cote, cote, 2222);
+    CSRGraph *csr = graph ? buildCSR(graph) : NULL;
+    if (graph)
+        freeGraph(graph);
+    if (!csr)
     {
-        float minDistance = FLT_MAX;
-        int bestVehicule = -1;
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+        return 1;
+    }
 
-        // Trouver le meilleur véhicule pour le colis
-        for (int j = 0; j < nbVehicules; j++)
+    LotColis colis;
+    Flotte flotte;
+    Carte carte;
+    FileColis file;
+    initialiserLotColis(&colis);
+    initialiserFlotte(&flotte);
+    initialiserFileColis(&file);
+    int *ordre = malloc(nbColis * sizeof(int));
+    int *affectation = malloc(nbColis * sizeof(int));
+    float *distance = malloc(nbColis * sizeof(float));
+    int *expedies = malloc(2 * (size_t)nbColis * sizeof(int));
+    uint64_t *reste = malloc(nbColis * sizeof(uint64_t));
+    bool ok = ordre && affectation && distance && expedies && reste &&
+              benchmarkFlotte(csr->V, &flotte, nbVehicules, &colis, nbColis, pourcentUrgents, 4242);
+    if (!ok || !initialiserCarte(&carte, csr, METRIC_DISTANCE))
+    {
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+        libererLotColis(&colis);
+        libererFlotte(&flotte);
+        free(ordre);
+        free(affectation);
+        free(distance);
+        free(expedies);
+        free(reste);
+        freeCSR(csr);
+        return 1;
+    }
+    for (int j = 0; j < nbVehicules; j++)
+        carteLigne(&carte, flotte.villeActuelle[j]);
+
+    int nbUrgents = 0;
+    for (int i = 0; i < nbColis; i++)
+        nbUrgents += colis.urgent[i];
+    printf("Grille %dx%d (%d villes), %d colis dont %d urgents, %d véhicules\n", cote, cote, csr->V, nbColis,
+           nbUrgents, nbVehicules);
+    printf("%-16s %10s %12s %9s %17s %9s\n", "ordre", "file", "affectation", "affectés", "urgents affectés",
+           "km/colis");
+    for (int o = 0; o < 2 && ok; o++)
+    {
+        viderTournees(&flotte);
+        double tFile = 0, t0;
+        int affectes;
+        if (o == 0)
         {
-            if (vehicules[j].capaciteRestante >= colis[i].poids)
+            t0 = chronometre();
+            affectes = affecterColisIndexe(&flotte, &colis, AFFECTATION_PROCHE, &carte, affectation, distance);
+        }
+        else
+        {
+            t0 = chronometre();
+            initialiserFileColis(&file);
+            for (int i = 0; i < nbColis && ok; i++)
+                ok = fileColisAjouter(&file, &colis, i);
+            tFile = chronometre() - t0;
+            t0 = chronometre();
+            affectes = ok ? affecterColisFile(&flotte, &colis, &file, AFFECTATION_PROCHE, &carte, ordre, affectation,
+                                              distance)
+                          : -1;
+            libererFileColis(&file);
+        }
+        double tAffectation = chronometre() - t0;
+        ok = affectes >= 0;
+
+        int urgentsAffectes = 0;
+        double km = 0;
+        for (int i = 0; i < nbColis && ok; i++)
+            if (affectation[i] >= 0)
             {
-                float d = carte->distances[vehicules[j].villeActuelle][colis[i].villeDest];
-                if (d < minDistance)
-                {
-                    minDistance = d;
-                    bestVehicule = j;
-                }
+                urgentsAffectes += colis.urgent[i];
+                km += distance[i];
             }
-        }
+        printf("%-16s %8.1fms %10.1fms %9d %16.1f%% %9.1f\n", nomsOrdres[o], tFile * 1000, tAffectation * 1000,
+               affectes, nbUrgents > 0 ? 100.0 * urgentsAffectes / nbUrgents : 0.0, affectes > 0 ? km / affectes : 0.0);
+    }
 
-        // Affecter le colis au véhicule trouvé
-        if (bestVehicule != -1)
+    // Flux : lots successifs, la moitié la plus prioritaire de ce qui attend part après chaque lot
+    int taille = (nbColis + nbLots - 1) / nbLots;
+    double tTas = 0, tTri = 0;
+    int nbTas = 0, nbTri = 0, differences = 0;
+    initialiserFileColis(&file);
+    if (ok)
+    {
+        double t0 = chronometre();
+        for (int debut = 0; debut < nbColis && ok; debut += taille)
         {
-            vehicules[bestVehicule].capaciteRestante -= colis[i].poids;
-            vehicules[bestVehicule].tournee[vehicules[bestVehicule].nbLivraisons++] = colis[i].villeDest;
-            printf("Colis %d affecté au véhicule %d (destination : %s, distance : %.1f km)\n",
-                   colis[i].id, bestVehicule, graph->cityNames[colis[i].villeDest], minDistance);
+            int fin = debut + taille < nbColis ? debut + taille : nbColis;
+            for (int i = debut; i < fin && ok; i++)
+                ok = fileColisAjouter(&file, &colis, i);
+            int partants = fin == nbColis ? file.size : file.size / 2;
+            for (int k = 0; k < partants; k++)
+                expedies[nbTas++] = fileColisExtraire(&file);
         }
-        else
+        tTas = chronometre() - t0;
+
+        // Même flux en retriant tout le reste à chaque lot (ordre décroissant : départs en fin)
+        int attente = 0;
+        t0 = chronometre();
+        for (int debut = 0; debut < nbColis; debut += taille)
         {
-            printf("Colis %d non assigné : aucun véhicule disponible avec la capacité suffisante\n", colis[i].id);
+            int fin = debut + taille < nbColis ? debut + taille : nbColis;
+            for (int i = debut; i < fin; i++)
+                reste[attente++] = fileColisCle(&colis, i);
+            qsort(reste, attente, sizeof(uint64_t), compareClesDecroissantes);
+            int partants = fin == nbColis ? attente : attente / 2;
+            for (int k = 0; k < partants; k++)
+                expedies[nbColis + nbTri++] = (int)(uint32_t)reste[--attente];
         }
+        tTri = chronometre() - t0;
+        libererFileColis(&file);
     }
+    for (int k = 0; k < nbColis && ok; k++)
+        differences += expedies[k] != expedies[nbColis + k];
+    if (ok)
+        printf("Flux de %d lots de %d colis : tas %.1fms, tri complet du reste %.1fms (%.1fx), %d/%d expédiés, %d "
+               "écarts\n",
+               nbLots, taille, tTas * 1000, tTri * 1000, tTri / tTas, nbTas, nbTri, differences);
+    else
+        printf("Erreur : allocation mémoire échouée pour le benchmark.\n");
+
+    libererCarte(&carte);
+    libererLotColis(&colis);
+    libererFlotte(&flotte);
+    free(ordre);
+    free(affectation);
+    free(distance);
+    free(expedies);
+    free(reste);
+    freeCSR(csr);
+    return ok ? 0 : 1;
 }
 
-// ---------- AFFICHAGE TOURNEE ----------
-void afficherTournees(Vehicule *vehicules, int nbVehicules, Graph *graph)
+static const Benchmark benchmarks[] = {
+    {"csr", benchmarkCSR, "passe de relaxation et BFS : listes chaînées vs CSR [V] [E] [passes]"},
+    {"instantane", benchmarkInstantane, "démarrage JSON vs instantané binaire projeté [V] [E]"},
+    {"floyd", benchmarkFloyd, "Floyd-Warshall classique vs par tuiles (scalaire/SSE/AVX2) [V1 V2 ...]"},
+    {"floyd-threads", benchmarkFloydThreads, "accélération de Floyd-Warshall par nombre de threads [V] [threadsMax]"},
+    {"dijkstra", benchmarkDijkstra, "Dijkstra (tas 4-aire) vs Bellman-Ford [E1 E2 ...]"},
+    {"spfa", benchmarkSPFA, "Bellman-Ford à arrêt anticipé vs SPFA sur coûts négatifs [E1 E2 ...]"},
+    {"lot", benchmarkLot, "Bellman-Ford source par source vs lot de sources groupé [E] [maxTime] [K1 K2 ...]"},
+    {"ch", benchmarkCH, "hiérarchie de contraction : prétraitement et requêtes point à point vs Dijkstra [côté1 côté2 ...]"},
+    {"alt", benchmarkALT, "A* avec repères (ALT) vs Dijkstra point à point : sommets fixés [repères] [côté1 côté2 ...]"},
+    {"acces", benchmarkAcces, "accessibilité : BFS simple vs BFS bidirectionnel réutilisable, en req/s [E1 E2 ...]"},
+    {"index", benchmarkIndex, "index d'accessibilité (CFC + intervalles) : requêtes et insertions incrémentales [E1 E2 ...]"},
+    {"dfs", benchmarkDFS, "parcours en profondeur à pile explicite sur longues chaînes : DFS, tri topo, CFC [N1 N2 ...]"},
+    {"cycles", benchmarkCycles, "circuits orientés : détection, bilan des CFC cycliques, règle non orientée [E1 E2 ...]"},
+    {"bfs", benchmarkBFS, "BFS à direction optimisée (descendant/montant, ensembles de bits) vs BFS classique [E1 E2 ...]"},
+    {"composantes", benchmarkComposantes, "composantes connexes : BFS séquentiel vs union-find parallèle (CAS) [E1 E2 ...]"},
+    {"stats", benchmarkStats, "statistiques du réseau : passe parallèle sur les arcs, diamètre par BFS échantillonnés [E1 E2 ...]"},
+    {"flotte", benchmarkAffectation, "affectation gloutonne : parcours de la flotte vs index par ville et capacité [colis véhicules ...]"},
+    {"capacites", benchmarkCapacites, "poids et volume : poids seul vs modes proche et remplissage, filtre SIMD [colis véhicules ...]"},
+    {"priorites", benchmarkPriorites, "file de priorité des colis : urgents d'abord, flux par lots [colis véhicules %urgents lots]"},
+    {"rcsp", benchmarkRCSP, "chemin sous contrainte de temps : Dijkstra vs étiquettes de Pareto [maxTime] [E1 E2 ...]"},
+    {"chargement", benchmarkChargement, "temps de chargement JSON (cJSON et flux) par taille [E1 E2 ...]"},
+};
+
+// Fonction pour lancer un benchmark par son nom (main --bench <nom> ...)
+int lancerBenchmark(int argc, char *argv[])
 {
-    printf("\n===== Tournées des véhicules (GLOUTONNE) =====\n");
-    for (int i = 0; i < nbVehicules; i++)
+    int nbBenchmarks = (int)(sizeof(benchmarks) / sizeof(benchmarks[0]));
+    if (argc >= 1)
     {
-        printf("Tournée du véhicule %d : ", vehicules[i].id);
-        for (int j = 0; j < vehicules[i].nbLivraisons; j++)
+        for (int i = 0; i < nbBenchmarks; i++)
         {
-            printf("-> %s ", graph->cityNames[vehicules[i].tournee[j]]);
+            if (strcmp(argv[0], benchmarks[i].nom) == 0)
+                return benchmarks[i].lancer(argc - 1, argv + 1);
         }
-        printf("\n");
+        printf("Erreur : benchmark inconnu (%s).\n", argv[0]);
     }
-}
\ No newline at end of file
+
+    printf("Usage : main --bench <nom> [paramètres]\n");
+    for (int i = 0; i < nbBenchmarks; i++)
+        printf("  %-12s %s\n", benchmarks[i].nom, benchmarks[i].description);
+    return 1;
+}